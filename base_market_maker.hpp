@@ -6,17 +6,21 @@
 #include "underlying.hpp"
 #include <stdexcept>
 
-class BaseMarketMaker {
-public:
+// The one book a market maker trades against. Strategy cores refer to it
+// rather than keeping positions of their own.
+struct MarketState {
     UnderlyingVector underlying_state;
     OptionVector active_option_state;
     Position position;
+};
+
+class BaseMarketMaker : public MarketState {
+public:
     TradeCallback trade_underlying_callback;
     
     BaseMarketMaker(UnderlyingVector underlying_initial_state,
                     OptionVector option_initial_state)
-        :   underlying_state(std::move(underlying_initial_state)),
-            active_option_state(std::move(option_initial_state)) {
+        :   MarketState{std::move(underlying_initial_state), std::move(option_initial_state), Position{}} {
         
         this->underlying_state.reserve(8);
         this->active_option_state.reserve(32);
@@ -34,7 +38,9 @@ public:
             throw std::invalid_argument("Trade quantity must be positive");
         }
         
-        trade_underlying_callback(underlying_id, quantity);
+        if (trade_underlying_callback) {
+            trade_underlying_callback(underlying_id, quantity);
+        }
         position.add_underlying_quantity(underlying_id, quantity);
     }
     
@@ -65,7 +71,9 @@ public:
             throw std::invalid_argument("Trade quantity must be positive");
         }
         
-        trade_underlying_callback(underlying_id, -quantity);
+        if (trade_underlying_callback) {
+            trade_underlying_callback(underlying_id, -quantity);
+        }
         position.add_underlying_quantity(underlying_id, -quantity);
     }
 };
\ No newline at end of file
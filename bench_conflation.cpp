@@ -0,0 +1,224 @@
+#include "conflation.hpp"
+#include "market_maker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int BURSTS = 40;
+constexpr int TICKS_PER_BURST = 200;
+constexpr int TICKS_PER_STEP = 100;
+constexpr auto BURST_GAP = std::chrono::milliseconds(5);
+
+struct MarketEvent {
+    UnderlyingPtr tick;
+    OptionVector step;
+    Clock::time_point published;
+};
+
+struct StalenessReport {
+    std::uint64_t updates = 0;
+    std::uint64_t steps = 0;
+    double total_us = 0.0;
+    double max_us = 0.0;
+    double catch_up_ms = 0.0;
+    
+    void record(Clock::time_point published) {
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - published).count();
+        total_us += us;
+        max_us = std::max(max_us, us);
+        ++updates;
+    }
+};
+
+UnderlyingVector create_underlyings() {
+    UnderlyingVector underlyings;
+    underlyings.emplace_back(std::make_shared<Underlying>("CULIONS", 1, 150.0, 0.5, 0.5, 0.1, 0.5, 0.5));
+    underlyings.emplace_back(std::make_shared<Underlying>("SEAS", 2, 200.0, 0.5, 0.5, 0.2, 0.5, 0.5));
+    return underlyings;
+}
+
+OptionVector create_options(const UnderlyingVector& underlyings) {
+    OptionVector options;
+    OptionId next_id = 1;
+    for (const auto& u_ptr : underlyings) {
+        Strike atm = static_cast<Strike>(u_ptr->valuation);
+        for (Steps expiry : {2, 40, 120}) {
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::CALL, expiry, atm));
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::PUT, expiry, atm));
+        }
+    }
+    return options;
+}
+
+template <typename Publish>
+void produce(UnderlyingVector underlyings, OptionVector options, Publish&& publish) {
+    std::mt19937 gen(7);
+    int tick = 0;
+    for (int burst = 0; burst < BURSTS; ++burst) {
+        for (int i = 0; i < TICKS_PER_BURST; ++i, ++tick) {
+            auto& u = underlyings[tick % underlyings.size()];
+            u = u->advance_step(gen);
+            publish(u, OptionVector{});
+            
+            if ((tick + 1) % TICKS_PER_STEP == 0) {
+                for (auto& opt_ptr : options) {
+                    opt_ptr = opt_ptr->advance_step();
+                }
+                publish(nullptr, options);
+            }
+        }
+        std::this_thread::sleep_for(BURST_GAP);
+    }
+}
+
+void fill_some(MarketMaker& mm) {
+    for (const auto& opt_ptr : mm.active_option_state) {
+        mm.make_market(*opt_ptr);
+    }
+}
+
+StalenessReport run_direct() {
+    auto underlyings = create_underlyings();
+    auto options = create_options(underlyings);
+    MarketMaker mm{UnderlyingVector(underlyings), OptionVector(options)};
+    mm.register_trade_underlying_callback([](UnderlyingId, Quantity) {});
+    mm.on_bid_hit(*options[1], 1.0);
+    mm.on_offer_hit(*options[4], 1.0);
+    
+    std::mutex mutex;
+    std::deque<MarketEvent> queue;
+    std::atomic<bool> done{false};
+    
+    std::thread producer([&] {
+        produce(underlyings, options, [&](UnderlyingPtr tick, OptionVector step) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(MarketEvent{std::move(tick), std::move(step), Clock::now()});
+        });
+        done = true;
+    });
+    
+    StalenessReport report;
+    UnderlyingVector state = underlyings;
+    OptionVector option_state = options;
+    Clock::time_point producer_done{};
+    
+    while (true) {
+        MarketEvent event;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.empty()) {
+                if (done) break;
+                continue;
+            }
+            event = std::move(queue.front());
+            queue.pop_front();
+        }
+        if (done && producer_done == Clock::time_point{}) {
+            producer_done = Clock::now();
+        }
+        
+        if (event.tick) {
+            for (auto& u : state) {
+                if (u->underlying_id == event.tick->underlying_id) u = event.tick;
+            }
+        } else {
+            option_state = event.step;
+            ++report.steps;
+        }
+        
+        mm.on_step_advance(UnderlyingVector(state), OptionVector(option_state));
+        fill_some(mm);
+        report.record(event.published);
+    }
+    
+    producer.join();
+    if (producer_done != Clock::time_point{}) {
+        report.catch_up_ms = std::chrono::duration<double, std::milli>(Clock::now() - producer_done).count();
+    }
+    return report;
+}
+
+StalenessReport run_conflated(ConflationStats& stats) {
+    auto underlyings = create_underlyings();
+    auto options = create_options(underlyings);
+    MarketMaker mm{UnderlyingVector(underlyings), OptionVector(options)};
+    mm.register_trade_underlying_callback([](UnderlyingId, Quantity) {});
+    mm.on_bid_hit(*options[1], 1.0);
+    mm.on_offer_hit(*options[4], 1.0);
+    
+    MarketDataConflator conflator(underlyings, options);
+    std::atomic<bool> done{false};
+    
+    std::thread producer([&] {
+        produce(underlyings, options, [&](UnderlyingPtr tick, OptionVector step) {
+            if (tick) {
+                conflator.publish_tick(std::move(tick));
+            } else {
+                conflator.publish_step(std::move(step));
+            }
+        });
+        done = true;
+    });
+    
+    StalenessReport report;
+    ConflatedUpdate update;
+    Clock::time_point producer_done{};
+    
+    while (true) {
+        bool finished = done;
+        if (!conflator.drain(update)) {
+            if (finished) break;
+            continue;
+        }
+        if (finished && producer_done == Clock::time_point{}) {
+            producer_done = Clock::now();
+        }
+        
+        report.steps += update.steps_elapsed;
+        Clock::time_point oldest = update.oldest_update;
+        mm.on_conflated_update(std::move(update));
+        fill_some(mm);
+        report.record(oldest);
+    }
+    
+    producer.join();
+    if (producer_done != Clock::time_point{}) {
+        report.catch_up_ms = std::chrono::duration<double, std::milli>(Clock::now() - producer_done).count();
+    }
+    stats = conflator.stats();
+    return report;
+}
+
+void print_report(const char* label, const StalenessReport& r) {
+    std::cout << std::setw(10) << label << std::setw(10) << r.updates << std::setw(8) << r.steps
+                << std::fixed << std::setprecision(1)
+                << std::setw(14) << (r.updates ? r.total_us / r.updates : 0.0)
+                << std::setw(14) << r.max_us << std::setw(14) << r.catch_up_ms << "\n";
+}
+
+}
+
+int main() {
+    std::cout << BURSTS << " bursts of " << TICKS_PER_BURST << " ticks, a step every "
+                << TICKS_PER_STEP << " ticks\n";
+    std::cout << std::setw(10) << "mode" << std::setw(10) << "updates" << std::setw(8) << "steps"
+                << std::setw(14) << "mean age us" << std::setw(14) << "max age us"
+                << std::setw(14) << "catch-up ms" << "\n";
+    
+    print_report("direct", run_direct());
+    
+    ConflationStats stats;
+    print_report("conflated", run_conflated(stats));
+    std::cout << "conflated " << stats.ticks_conflated << " of " << stats.ticks_received
+                << " ticks into " << stats.updates_drained << " updates\n";
+    
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "market_maker.hpp"
+#include "static_market_maker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+constexpr int QUOTE_ROUNDS = 20000;
+constexpr int TIMING_TRIALS = 7;
+constexpr int REPLAY_STEPS = 30;
+constexpr double HIT_PROBABILITY = 0.1;
+
+UnderlyingVector make_underlyings() {
+    UnderlyingVector underlyings;
+    underlyings.emplace_back(std::make_shared<Underlying>("CULIONS", 1, 150.0, 0.5, 2.0, 0.1, 0.5, 2.0));
+    underlyings.emplace_back(std::make_shared<Underlying>("SEAS", 2, 200.0, 0.5, 3.0, 0.2, 0.5, 3.0));
+    return underlyings;
+}
+
+OptionVector make_chain(const UnderlyingVector& underlyings) {
+    OptionVector options;
+    OptionId next_id = 1000;
+    for (const auto& u_ptr : underlyings) {
+        for (int offset = -10; offset <= 10; offset += 2) {
+            Strike strike = static_cast<Strike>(u_ptr->valuation) + offset;
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::CALL, 20, strike));
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::PUT, 20, strike));
+        }
+    }
+    return options;
+}
+
+template <typename Quoter>
+double time_quotes(Quoter& quoter, const OptionVector& options, Price& checksum) {
+    for (const auto& opt_ptr : options) {
+        quoter.make_market(*opt_ptr);
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < QUOTE_ROUNDS; ++round) {
+        for (const auto& opt_ptr : options) {
+            auto [bid, ask] = quoter.make_market(*opt_ptr);
+            checksum += ask - bid;
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    double quotes = static_cast<double>(QUOTE_ROUNDS) * options.size();
+    return std::chrono::duration<double, std::nano>(elapsed).count() / quotes;
+}
+
+// Quotes, fills and steps from a fixed seed, so all three implementations see
+// the same flow. Every quote goes into the trace followed by the final marks
+// and positions.
+template <typename Quoter>
+std::vector<Price> replay(Quoter& quoter, const UnderlyingVector& underlyings, const OptionVector& options) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+    UnderlyingVector u_state = underlyings;
+    OptionVector o_state = options;
+    std::vector<Price> trace;
+    
+    for (int step = 0; step < REPLAY_STEPS; ++step) {
+        for (const auto& opt_ptr : o_state) {
+            auto [bid, ask] = quoter.make_market(*opt_ptr);
+            trace.push_back(bid);
+            trace.push_back(ask);
+            
+            double draw = uniform(gen);
+            if (draw < HIT_PROBABILITY) {
+                quoter.on_bid_hit(*opt_ptr, bid);
+            } else if (draw < 2 * HIT_PROBABILITY) {
+                quoter.on_offer_hit(*opt_ptr, ask);
+            }
+        }
+        
+        for (auto& u_ptr : u_state) {
+            u_ptr = u_ptr->advance_step(gen);
+        }
+        for (auto& opt_ptr : o_state) {
+            opt_ptr = opt_ptr->advance_step();
+        }
+        quoter.on_step_advance(u_state, o_state);
+    }
+    
+    for (const auto& opt_ptr : o_state) {
+        trace.push_back(quoter.price_option(*opt_ptr));
+    }
+    return trace;
+}
+
+void append_book(std::vector<Price>& trace, Price value, const Position& position,
+                 const UnderlyingVector& underlyings, const OptionVector& options) {
+    trace.push_back(value);
+    for (const auto& opt_ptr : options) {
+        trace.push_back(position.option_quantity(opt_ptr->option_id));
+    }
+    for (const auto& u_ptr : underlyings) {
+        trace.push_back(position.underlying_quantity(u_ptr->underlying_id));
+    }
+}
+
+bool check_identical(std::string_view label, const StrategyParams& params,
+                     const UnderlyingVector& underlyings, const OptionVector& options) {
+    MarketMaker virtual_mm{UnderlyingVector(underlyings), OptionVector(options), params};
+    auto expected = replay(static_cast<BaseMarketMaker&>(virtual_mm), underlyings, options);
+    append_book(expected, virtual_mm.mark_to_market(), virtual_mm.position, underlyings, options);
+    
+    VirtualMarketMakerAdapter<> adapter{UnderlyingVector(underlyings), OptionVector(options), params};
+    auto adapted = replay(static_cast<BaseMarketMaker&>(adapter), underlyings, options);
+    append_book(adapted, adapter.mark_to_market(), adapter.position, underlyings, options);
+    
+    StaticMarketMaker<> static_mm{UnderlyingVector(underlyings), OptionVector(options), params};
+    auto inlined = replay(static_mm, underlyings, options);
+    append_book(inlined, static_mm.mark_to_market(), static_mm.position, underlyings, options);
+    
+    bool identical = expected == adapted && expected == inlined;
+    std::cout << "  " << std::left << std::setw(28) << label
+                << (identical ? "identical" : "MISMATCH") << " (" << expected.size() << " values)\n";
+    return identical;
+}
+
+void report(std::string_view label, double ns_per_quote, double baseline) {
+    std::cout << "  " << std::left << std::setw(28) << label
+                << std::right << std::fixed << std::setprecision(1) << ns_per_quote << " ns/quote  "
+                << std::setprecision(3) << baseline / ns_per_quote << "x\n";
+}
+
+}
+
+int main() {
+    auto underlyings = make_underlyings();
+    auto options = make_chain(underlyings);
+    Price checksum = 0.0;
+    
+    std::cout << "Replay of " << REPLAY_STEPS << " steps against MarketMaker\n";
+    StrategyParams stressed;
+    stressed.max_loss = -25.0;
+    bool identical = check_identical("default params", {}, underlyings, options);
+    identical = check_identical("max_loss -25", stressed, underlyings, options) && identical;
+    
+    std::cout << "Quote loop over " << options.size() << " options, " << QUOTE_ROUNDS
+              << " rounds, best of " << TIMING_TRIALS << " interleaved trials\n";
+    
+    MarketMaker virtual_mm{UnderlyingVector(underlyings), OptionVector(options)};
+    BaseMarketMaker& virtual_base = virtual_mm;
+    VirtualMarketMakerAdapter<> adapter{UnderlyingVector(underlyings), OptionVector(options)};
+    BaseMarketMaker& adapter_base = adapter;
+    StaticMarketMaker<> static_mm{UnderlyingVector(underlyings), OptionVector(options)};
+    
+    // All three run the same core, so the gaps left are dispatch and noise.
+    // Interleaving the trials keeps frequency drift from favouring one of them.
+    double virtual_ns = 1e300;
+    double adapter_ns = 1e300;
+    double static_ns = 1e300;
+    for (int trial = 0; trial < TIMING_TRIALS; ++trial) {
+        virtual_ns = std::min(virtual_ns, time_quotes(virtual_base, options, checksum));
+        adapter_ns = std::min(adapter_ns, time_quotes(adapter_base, options, checksum));
+        static_ns = std::min(static_ns, time_quotes(static_mm, options, checksum));
+    }
+    
+    report("MarketMaker (virtual)", virtual_ns, virtual_ns);
+    report("Adapter (virtual)", adapter_ns, virtual_ns);
+    report("StaticMarketMaker (static)", static_ns, virtual_ns);
+    
+    std::cout << "checksum " << checksum << "\n";
+    return identical ? 0 : 1;
+}
\ No newline at end of file
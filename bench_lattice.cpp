@@ -0,0 +1,64 @@
+#include "lattice_pricer.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+namespace {
+
+template <typename Fn>
+double time_ns(Fn&& fn, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / repeats;
+}
+
+}
+
+int main() {
+    Underlying underlying("BENCH", 1, 1000.0, 0.5, 1.0, 0.1, 0.5, 1.0);
+    LatticePricer pricer;
+    
+    // Narrow bands trade truncation error for speed. Each row prices the same
+    // contract with a fixed band of k standard deviations, and the last row of
+    // each block uses the k picked for the default tolerance.
+    std::cout << "Pruned vs full lattice by band width, default tolerance " << pricer.pruning.tolerance
+              << ", pruning from n = " << pricer.pruning.min_steps << "\n";
+    std::cout << std::setw(7) << "n" << std::setw(6) << "type" << std::setw(9) << "k"
+                << std::setw(8) << "band" << std::setw(14) << "full us" << std::setw(14) << "pruned us"
+                << std::setw(10) << "speedup" << std::setw(14) << "abs error" << std::setw(14) << "bound\n";
+    
+    for (Steps n : {pricer.pruning.min_steps, 1000, 2000, 5000, 10000}) {
+        for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+            Option option(1, type, n, 1010, underlying.underlying_id, underlying.name);
+            int repeats = std::max(3, 2000000 / (n * n / 10 + 1));
+            
+            Price full = 0.0;
+            double full_ns = time_ns([&] { full = pricer.price_full(option, underlying, underlying.valuation); }, repeats);
+            
+            double default_k = pricer.price_pruned(option, underlying, underlying.valuation,
+                                                   pricer.pruning.tolerance).k_sigma;
+            for (double k : {1.0, 2.0, 3.0, 4.0, 5.0, default_k}) {
+                PrunedLatticeResult pruned{};
+                double pruned_ns = time_ns([&] { pruned = pricer.price_in_band(option, underlying, underlying.valuation, k); },
+                                           repeats);
+                
+                std::cout << std::setw(7) << n << std::setw(6) << to_string_view(type)
+                            << std::fixed << std::setprecision(1)
+                            << std::setw(8) << k << (k == default_k ? "*" : " ")
+                            << std::setw(8) << pruned.band_width
+                            << std::setw(14) << full_ns / 1000.0 << std::setw(14) << pruned_ns / 1000.0
+                            << std::setw(9) << full_ns / pruned_ns << "x"
+                            << std::scientific << std::setprecision(2)
+                            << std::setw(14) << std::abs(pruned.price - full)
+                            << std::setw(13) << pruned.truncation_error << "\n"
+                            << std::defaultfloat;
+            }
+        }
+    }
+    
+    std::cout << "* k picked for the default tolerance\n";
+    return 0;
+}
\ No newline at end of file
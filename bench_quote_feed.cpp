@@ -0,0 +1,113 @@
+#include "quote_feed.hpp"
+#include "metrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+constexpr int CHAIN_SIZE = 1000;
+constexpr int REFRESHES = 2000;
+
+template <typename Fn>
+double time_ns_per_quote(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REFRESHES; ++r) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double(REFRESHES) * CHAIN_SIZE);
+}
+
+struct ReaderResult {
+    std::uint64_t received = 0;
+    std::uint64_t lost = 0;
+    std::uint64_t out_of_order = 0;
+};
+
+}
+
+int main() {
+    std::string name = "/mm_bench_quotes_" + std::to_string(::getpid());
+    std::vector<QuoteRecord> records;
+    for (int i = 0; i < CHAIN_SIZE; ++i) {
+        records.push_back(QuoteRecord{i + 1, 0, 1.0 + i * 0.01, 1.1 + i * 0.01, 0, 0});
+    }
+    
+    // The baseline formats the same fields the ring writes, so the comparison
+    // measures formatting against publication rather than contract descriptions.
+    std::ostringstream out;
+    std::uint64_t stream_sequence = 0;
+    double stream_ns = time_ns_per_quote([&] {
+        out.str("");
+        std::int64_t now = monotonic_time_ns();
+        for (const QuoteRecord& q : records) {
+            out << q.option_id << ' ' << std::fixed << std::setprecision(4) << q.bid << ' ' << q.ask
+                << ' ' << ++stream_sequence << ' ' << now << '\n';
+        }
+    });
+    
+    QuotePublisher publisher(name, 1 << 16);
+    double single_ns = time_ns_per_quote([&] {
+        for (const QuoteRecord& q : records) {
+            publisher.publish(q.option_id, q.bid, q.ask);
+        }
+    });
+    double batch_ns = time_ns_per_quote([&] { publisher.publish(records.data(), records.size()); });
+    
+    std::cout << "Full-chain refresh of " << CHAIN_SIZE << " quotes, ns per quote\n";
+    std::cout << std::fixed << std::setprecision(1)
+                << "  iostream formatting  " << std::setw(8) << stream_ns << "\n"
+                << "  ring, per quote      " << std::setw(8) << single_ns << "\n"
+                << "  ring, batched chain  " << std::setw(8) << batch_ns << "\n";
+    
+    constexpr int READERS = 2;
+    std::atomic<bool> done{false};
+    std::vector<ReaderResult> results(READERS);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&, r] {
+            QuoteReader reader(name);
+            QuoteRecord buffer[512];
+            std::uint64_t last = reader.cursor() - 1;
+            while (true) {
+                bool finished = done.load(std::memory_order_acquire);
+                std::size_t n = reader.poll(buffer, std::size(buffer));
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (buffer[i].sequence <= last) ++results[r].out_of_order;
+                    last = buffer[i].sequence;
+                }
+                results[r].received += n;
+                if (finished && n == 0) break;
+            }
+            results[r].lost = reader.lost();
+        });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::uint64_t start_sequence = publisher.published();
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REFRESHES; ++r) {
+        publisher.publish(records.data(), records.size());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::uint64_t published = publisher.published() - start_sequence;
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    std::cout << "\nPublished " << published << " quotes in " << std::setprecision(3) << seconds * 1000
+                << " ms (" << std::setprecision(1) << published / seconds / 1e6 << "M quotes/s) to "
+                << READERS << " concurrent readers\n";
+    for (int r = 0; r < READERS; ++r) {
+        std::cout << "  reader " << r << ": received " << results[r].received << ", skipped on overrun "
+                    << results[r].lost << ", out of order " << results[r].out_of_order << "\n";
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "conflation.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+MarketDataConflator::MarketDataConflator(UnderlyingVector initial_underlyings, OptionVector initial_options)
+    : latest_(std::move(initial_underlyings)), options_(std::move(initial_options)) {
+    
+    index_.reserve(latest_.size());
+    for (size_t i = 0; i < latest_.size(); ++i) {
+        index_.emplace(latest_[i]->underlying_id, i);
+    }
+    tick_pending_.assign(latest_.size(), 0);
+    
+    for (const auto& opt_ptr : options_) {
+        if (opt_ptr->steps_until_expiry == 0) {
+            expired_.insert(opt_ptr->option_id);
+        }
+    }
+}
+
+void MarketDataConflator::publish_tick(UnderlyingPtr underlying) {
+    if (!underlying) {
+        throw std::invalid_argument("Tick must carry an underlying state");
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = index_.try_emplace(underlying->underlying_id, latest_.size());
+    if (inserted) {
+        latest_.push_back(std::move(underlying));
+        tick_pending_.push_back(1);
+    } else {
+        if (tick_pending_[it->second]) {
+            ++pending_conflated_;
+            ++stats_.ticks_conflated;
+        }
+        latest_[it->second] = std::move(underlying);
+        tick_pending_[it->second] = 1;
+    }
+    
+    ++pending_ticks_;
+    ++stats_.ticks_received;
+    mark_pending();
+}
+
+void MarketDataConflator::publish_step(OptionVector option_state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    for (const auto& opt_ptr : option_state) {
+        if (opt_ptr->steps_until_expiry == 0 && expired_.insert(opt_ptr->option_id).second) {
+            expiries_.push_back(ExpiryEvent{opt_ptr->option_id, opt_ptr->underlying_id,
+                                            latest_ticks(opt_ptr->underlying_id)});
+        }
+    }
+    
+    options_ = std::move(option_state);
+    ++pending_steps_;
+    ++stats_.steps_received;
+    mark_pending();
+}
+
+bool MarketDataConflator::drain(ConflatedUpdate& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pending_) {
+        return false;
+    }
+    
+    out.underlyings = latest_;
+    out.options = options_;
+    out.expiries.clear();
+    out.expiries.swap(expiries_);
+    out.steps_elapsed = pending_steps_;
+    out.ticks_received = pending_ticks_;
+    out.ticks_conflated = pending_conflated_;
+    out.oldest_update = oldest_update_;
+    
+    std::fill(tick_pending_.begin(), tick_pending_.end(), 0);
+    pending_ = false;
+    pending_steps_ = 0;
+    pending_ticks_ = 0;
+    pending_conflated_ = 0;
+    ++stats_.updates_drained;
+    return true;
+}
+
+ConflationStats MarketDataConflator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void MarketDataConflator::mark_pending() {
+    if (!pending_) {
+        pending_ = true;
+        oldest_update_ = std::chrono::steady_clock::now();
+    }
+}
+
+Ticks MarketDataConflator::latest_ticks(UnderlyingId underlying_id) const {
+    auto it = index_.find(underlying_id);
+    return (it != index_.end()) ? latest_[it->second]->valuation_ticks : 0;
+}
\ No newline at end of file
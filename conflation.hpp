@@ -0,0 +1,63 @@
+#pragma once
+
+#include "types.hpp"
+#include "option.hpp"
+#include "underlying.hpp"
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
+
+struct ExpiryEvent {
+    OptionId option_id;
+    UnderlyingId underlying_id;
+    Ticks underlying_ticks;
+};
+
+struct ConflatedUpdate {
+    UnderlyingVector underlyings;
+    OptionVector options;
+    std::vector<ExpiryEvent> expiries;
+    std::uint64_t steps_elapsed = 0;
+    std::uint64_t ticks_received = 0;
+    std::uint64_t ticks_conflated = 0;
+    std::chrono::steady_clock::time_point oldest_update{};
+};
+
+struct ConflationStats {
+    std::uint64_t ticks_received = 0;
+    std::uint64_t ticks_conflated = 0;
+    std::uint64_t steps_received = 0;
+    std::uint64_t updates_drained = 0;
+};
+
+class MarketDataConflator {
+public:
+    MarketDataConflator(UnderlyingVector initial_underlyings, OptionVector initial_options);
+    
+    MarketDataConflator(const MarketDataConflator&) = delete;
+    MarketDataConflator& operator=(const MarketDataConflator&) = delete;
+    
+    void publish_tick(UnderlyingPtr underlying);
+    void publish_step(OptionVector option_state);
+    bool drain(ConflatedUpdate& out);
+    
+    ConflationStats stats() const;
+
+private:
+    mutable std::mutex mutex_;
+    UnderlyingVector latest_;
+    std::unordered_map<UnderlyingId, std::size_t> index_;
+    std::vector<std::uint8_t> tick_pending_;
+    OptionVector options_;
+    std::unordered_set<OptionId> expired_;
+    std::vector<ExpiryEvent> expiries_;
+    bool pending_ = false;
+    std::uint64_t pending_steps_ = 0;
+    std::uint64_t pending_ticks_ = 0;
+    std::uint64_t pending_conflated_ = 0;
+    std::chrono::steady_clock::time_point oldest_update_{};
+    ConflationStats stats_;
+    
+    void mark_pending();
+    Ticks latest_ticks(UnderlyingId underlying_id) const;
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "greeks_cache.hpp"
+#include <algorithm>
+#include <functional>
+
+std::size_t GreeksKeyHash::operator()(const GreeksKey& key) const noexcept {
+    std::size_t h = std::hash<Ticks>{}(key.spot_ticks);
+    h ^= std::hash<OptionId>{}(key.option_id) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<Steps>{}(key.steps_until_expiry) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+std::size_t GreeksCache::bytes_per_entry() noexcept {
+    return sizeof(Entry) + sizeof(std::pair<const GreeksKey, std::uint32_t>) + 3 * sizeof(void*);
+}
+
+GreeksCache::GreeksCache(GreeksCacheConfig config)
+    : config_(config), capacity_(std::max<std::size_t>(1, config.memory_budget_bytes / bytes_per_entry())) {
+    
+    std::size_t initial = std::min<std::size_t>(capacity_, 1024);
+    entries.reserve(initial);
+    index.reserve(initial);
+    stats_.capacity = capacity_;
+}
+
+const Greeks* GreeksCache::find(const GreeksKey& key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    
+    ++stats_.hits;
+    std::uint32_t slot = it->second;
+    entries[slot].epoch = epoch;
+    if (slot != head) {
+        unlink(slot);
+        push_front(slot);
+    }
+    return &entries[slot].greeks;
+}
+
+void GreeksCache::insert(const GreeksKey& key, const Greeks& greeks) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        Entry& entry = entries[it->second];
+        entry.greeks = greeks;
+        entry.epoch = epoch;
+        if (it->second != head) {
+            unlink(it->second);
+            push_front(it->second);
+        }
+        return;
+    }
+    
+    evict_stale(config_.max_evictions_per_insert);
+    while (index.size() >= capacity_) {
+        evict_tail();
+    }
+    
+    std::uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        entries[slot] = Entry{key, greeks, epoch, NIL, NIL};
+    } else {
+        slot = static_cast<std::uint32_t>(entries.size());
+        entries.push_back(Entry{key, greeks, epoch, NIL, NIL});
+    }
+    
+    index.emplace(key, slot);
+    push_front(slot);
+    ++stats_.insertions;
+    stats_.size = index.size();
+}
+
+void GreeksCache::advance_epoch() {
+    ++epoch;
+    evict_stale(config_.max_evictions_per_step);
+}
+
+void GreeksCache::clear() {
+    entries.clear();
+    free_slots.clear();
+    index.clear();
+    head = NIL;
+    tail = NIL;
+    stats_.size = 0;
+}
+
+void GreeksCache::unlink(std::uint32_t slot) noexcept {
+    Entry& entry = entries[slot];
+    if (entry.prev != NIL) {
+        entries[entry.prev].next = entry.next;
+    } else {
+        head = entry.next;
+    }
+    if (entry.next != NIL) {
+        entries[entry.next].prev = entry.prev;
+    } else {
+        tail = entry.prev;
+    }
+    entry.prev = NIL;
+    entry.next = NIL;
+}
+
+void GreeksCache::push_front(std::uint32_t slot) noexcept {
+    Entry& entry = entries[slot];
+    entry.prev = NIL;
+    entry.next = head;
+    if (head != NIL) {
+        entries[head].prev = slot;
+    }
+    head = slot;
+    if (tail == NIL) {
+        tail = slot;
+    }
+}
+
+void GreeksCache::evict_tail() {
+    std::uint32_t slot = tail;
+    if (slot == NIL) {
+        return;
+    }
+    
+    unlink(slot);
+    index.erase(entries[slot].key);
+    free_slots.push_back(slot);
+    ++stats_.evictions;
+    stats_.size = index.size();
+}
+
+void GreeksCache::evict_stale(std::size_t limit) {
+    for (std::size_t i = 0; i < limit && tail != NIL; ++i) {
+        if (entries[tail].epoch + config_.retention_steps >= epoch) {
+            return;
+        }
+        evict_tail();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+
+struct GreeksKey {
+    OptionId option_id;
+    Steps steps_until_expiry;
+    Ticks spot_ticks;
+    
+    bool operator==(const GreeksKey& other) const noexcept {
+        return option_id == other.option_id &&
+                steps_until_expiry == other.steps_until_expiry &&
+                spot_ticks == other.spot_ticks;
+    }
+};
+
+struct GreeksKeyHash {
+    std::size_t operator()(const GreeksKey& key) const noexcept;
+};
+
+struct GreeksCacheConfig {
+    std::size_t memory_budget_bytes = 16u << 20;
+    std::uint64_t retention_steps = 2;
+    std::size_t max_evictions_per_step = 512;
+    std::size_t max_evictions_per_insert = 2;
+};
+
+struct GreeksCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;
+    std::uint64_t evictions = 0;
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+};
+
+class GreeksCache {
+public:
+    explicit GreeksCache(GreeksCacheConfig config = {});
+    
+    const Greeks* find(const GreeksKey& key);
+    void insert(const GreeksKey& key, const Greeks& greeks);
+    void advance_epoch();
+    void clear();
+    
+    std::size_t size() const noexcept { return index.size(); }
+    std::size_t capacity() const noexcept { return capacity_; }
+    const GreeksCacheStats& stats() const noexcept { return stats_; }
+    
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (std::uint32_t i = head; i != NIL; i = entries[i].next) {
+            fn(entries[i].key, entries[i].greeks);
+        }
+    }
+    
+    static std::size_t bytes_per_entry() noexcept;
+
+private:
+    static constexpr std::uint32_t NIL = static_cast<std::uint32_t>(-1);
+    
+    struct Entry {
+        GreeksKey key;
+        Greeks greeks;
+        std::uint64_t epoch;
+        std::uint32_t prev;
+        std::uint32_t next;
+    };
+    
+    GreeksCacheConfig config_;
+    std::size_t capacity_;
+    std::vector<Entry> entries;
+    std::vector<std::uint32_t> free_slots;
+    std::unordered_map<GreeksKey, std::uint32_t, GreeksKeyHash> index;
+    std::uint32_t head = NIL;
+    std::uint32_t tail = NIL;
+    std::uint64_t epoch = 0;
+    GreeksCacheStats stats_;
+    
+    void unlink(std::uint32_t slot) noexcept;
+    void push_front(std::uint32_t slot) noexcept;
+    void evict_tail();
+    void evict_stale(std::size_t limit);
+};
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "greeks_surface.hpp"
+#include <algorithm>
+#include <cmath>
+
+std::shared_ptr<const GreeksSurface> GreeksSurface::build(const Option& option, const Underlying& underlying,
+                                                          const GreeksSurfaceConfig& config,
+                                                          PricingEnginePtr engine, Steps first_steps) {
+    auto surface = std::make_shared<GreeksSurface>();
+    surface->engine_ = std::move(engine);
+    
+    int nodes = 2 * config.half_width_nodes + 1;
+    surface->option_id_ = option.option_id;
+    surface->first_steps_ = first_steps;
+    surface->layers_ = std::max(1, std::min(config.step_layers, first_steps));
+    surface->nodes_ = nodes;
+    surface->spacing_ = from_ticks(config.spacing_ticks);
+    surface->centre_ = from_ticks(underlying.valuation_ticks);
+    surface->origin_ = std::max(0.0, surface->centre_ - config.half_width_nodes * surface->spacing_);
+    surface->recentre_distance_ = config.recentre_fraction * config.half_width_nodes * surface->spacing_;
+    
+    size_t points = static_cast<size_t>(surface->layers_) * nodes;
+    surface->prices_.resize(points);
+    surface->deltas_.resize(points);
+    surface->gammas_.resize(points);
+    surface->cell_within_tolerance_.resize(points);
+    
+    Option layer_option = option;
+    Underlying bumped = underlying;
+    for (Steps layer = 0; layer < surface->layers_; ++layer) {
+        layer_option.steps_until_expiry = first_steps - layer;
+        size_t row = static_cast<size_t>(layer) * nodes;
+        
+        for (int k = 0; k < nodes; ++k) {
+            bumped.valuation = surface->origin_ + k * surface->spacing_;
+            bumped.valuation_ticks = to_ticks(bumped.valuation);
+            auto [price, delta, gamma] = surface->engine_->price_and_greeks(layer_option, bumped);
+            surface->prices_[row + k] = price;
+            surface->deltas_[row + k] = delta;
+            surface->gammas_[row + k] = gamma;
+        }
+        
+        // Lattice gamma is a finite difference and can spike between nodes, so its
+        // bound uses the larger second difference at either end of the cell.
+        const Price* deltas = surface->deltas_.data() + row;
+        const Price* gammas = surface->gammas_.data() + row;
+        auto gamma_curvature = [gammas, nodes](int k) {
+            if (k <= 0 || k + 1 >= nodes) return 0.0;
+            return std::abs(gammas[k + 1] - 2 * gammas[k] + gammas[k - 1]);
+        };
+        
+        for (int k = 0; k + 1 < nodes; ++k) {
+            Price bound = 0.25 * surface->spacing_ * std::abs(deltas[k + 1] - deltas[k]);
+            Price delta_bound = 0.25 * surface->spacing_ * std::abs(gammas[k + 1] - gammas[k]);
+            Price gamma_bound = 0.25 * std::max(gamma_curvature(k), gamma_curvature(k + 1));
+            bool usable = bound <= config.tolerance && delta_bound <= config.delta_tolerance
+                          && gamma_bound <= config.gamma_tolerance;
+            surface->cell_within_tolerance_[row + k] = usable ? 1 : 0;
+            if (usable) {
+                surface->error_bound_ = std::max(surface->error_bound_, bound);
+                surface->delta_error_bound_ = std::max(surface->delta_error_bound_, delta_bound);
+                surface->gamma_error_bound_ = std::max(surface->gamma_error_bound_, gamma_bound);
+            }
+        }
+    }
+    
+    return surface;
+}
+
+bool GreeksSurface::contains(Price spot) const noexcept {
+    return spot >= origin_ && spot <= origin_ + spacing_ * (nodes_ - 1);
+}
+
+bool GreeksSurface::needs_recentre(Price spot) const noexcept {
+    return std::abs(spot - centre_) > recentre_distance_;
+}
+
+std::optional<Greeks> GreeksSurface::interpolate(Steps steps, Price spot) const noexcept {
+    if (!covers(steps) || !contains(spot)) {
+        return std::nullopt;
+    }
+    
+    double position = (spot - origin_) / spacing_;
+    size_t row = static_cast<size_t>(first_steps_ - steps) * nodes_;
+    
+    // Spot usually sits on a node, since nodes are whole ticks apart and spot
+    // moves in ticks. Node values are exact, whatever the bounds of its cells.
+    double node = std::round(position);
+    if (std::abs(position - node) < 1e-9) {
+        size_t k = row + static_cast<size_t>(node);
+        return std::make_tuple(prices_[k], deltas_[k], gammas_[k]);
+    }
+    
+    size_t cell = row + std::min(static_cast<size_t>(position), nodes_ - 2);
+    if (!cell_within_tolerance_[cell]) {
+        return std::nullopt;
+    }
+    
+    double w = position - (cell - row);
+    auto lerp = [w, cell](const std::vector<Price>& values) {
+        return values[cell] + w * (values[cell + 1] - values[cell]);
+    };
+    
+    return std::make_tuple(lerp(prices_), lerp(deltas_), lerp(gammas_));
+}
+
+GreeksSurfaceBuilder::GreeksSurfaceBuilder(GreeksSurfaceConfig config)
+    : config_(config), worker_(&GreeksSurfaceBuilder::run, this) {}
+
+GreeksSurfaceBuilder::~GreeksSurfaceBuilder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+void GreeksSurfaceBuilder::request(const Option& option, const Underlying& underlying, PricingEnginePtr engine,
+                                   Steps first_steps) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(BuildRequest{option, underlying, std::move(engine), first_steps});
+    }
+    wake_.notify_one();
+}
+
+bool GreeksSurfaceBuilder::collect(std::vector<GreeksSurfacePtr>& out) {
+    if (!has_completed_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    
+    out.swap(completed_);
+    completed_.clear();
+    has_completed_.store(false, std::memory_order_release);
+    return !out.empty();
+}
+
+void GreeksSurfaceBuilder::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        
+        BuildRequest request = std::move(pending_.front());
+        pending_.pop_front();
+        lock.unlock();
+        
+        auto surface = GreeksSurface::build(request.option, request.underlying, config_, std::move(request.engine),
+                                            request.first_steps);
+        
+        lock.lock();
+        completed_.push_back(std::move(surface));
+        has_completed_.store(true, std::memory_order_release);
+    }
+}
\ No newline at end of file
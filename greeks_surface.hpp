@@ -0,0 +1,97 @@
+#pragma once
+
+#include "types.hpp"
+#include "option.hpp"
+#include "underlying.hpp"
+#include "pricing_engine.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+struct GreeksSurfaceConfig {
+    int half_width_nodes = 32;
+    int spacing_ticks = 10;
+    Price tolerance = 0.005;
+    Price delta_tolerance = 0.005;
+    Price gamma_tolerance = 0.005;
+    double recentre_fraction = 0.75;
+    // Expiry steps per surface. Each step moves spot and counts expiry down,
+    // so a surface covers the next few steps instead of only the current one.
+    int step_layers = 8;
+};
+
+class GreeksSurface {
+public:
+    static std::shared_ptr<const GreeksSurface> build(const Option& option, const Underlying& underlying,
+                                                      const GreeksSurfaceConfig& config,
+                                                      PricingEnginePtr engine, Steps first_steps);
+    
+    OptionId option_id() const noexcept { return option_id_; }
+    const PricingEngine* engine() const noexcept { return engine_.get(); }
+    Steps first_steps() const noexcept { return first_steps_; }
+    Steps last_steps() const noexcept { return first_steps_ - layers_ + 1; }
+    bool covers(Steps steps) const noexcept { return steps <= first_steps_ && steps >= last_steps(); }
+    Price error_bound() const noexcept { return error_bound_; }
+    Price delta_error_bound() const noexcept { return delta_error_bound_; }
+    Price gamma_error_bound() const noexcept { return gamma_error_bound_; }
+    
+    bool contains(Price spot) const noexcept;
+    bool needs_recentre(Price spot) const noexcept;
+    std::optional<Greeks> interpolate(Steps steps, Price spot) const noexcept;
+
+private:
+    OptionId option_id_ = 0;
+    PricingEnginePtr engine_;
+    Steps first_steps_ = 0;
+    Steps layers_ = 0;
+    std::size_t nodes_ = 0;
+    Price origin_ = 0.0;
+    Price spacing_ = 0.0;
+    Price centre_ = 0.0;
+    Price recentre_distance_ = 0.0;
+    Price error_bound_ = 0.0;
+    Price delta_error_bound_ = 0.0;
+    Price gamma_error_bound_ = 0.0;
+    std::vector<Price> prices_;
+    std::vector<Price> deltas_;
+    std::vector<Price> gammas_;
+    std::vector<std::uint8_t> cell_within_tolerance_;
+};
+
+using GreeksSurfacePtr = std::shared_ptr<const GreeksSurface>;
+
+class GreeksSurfaceBuilder {
+public:
+    explicit GreeksSurfaceBuilder(GreeksSurfaceConfig config = {});
+    ~GreeksSurfaceBuilder();
+    
+    GreeksSurfaceBuilder(const GreeksSurfaceBuilder&) = delete;
+    GreeksSurfaceBuilder& operator=(const GreeksSurfaceBuilder&) = delete;
+    
+    const GreeksSurfaceConfig& config() const noexcept { return config_; }
+    
+    void request(const Option& option, const Underlying& underlying, PricingEnginePtr engine, Steps first_steps);
+    bool collect(std::vector<GreeksSurfacePtr>& out);
+
+private:
+    struct BuildRequest {
+        Option option;
+        Underlying underlying;
+        PricingEnginePtr engine;
+        Steps first_steps;
+    };
+    
+    GreeksSurfaceConfig config_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<BuildRequest> pending_;
+    std::vector<GreeksSurfacePtr> completed_;
+    std::atomic<bool> has_completed_{false};
+    bool stopping_ = false;
+    std::thread worker_;
+    
+    void run();
+};
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "hedge_execution.hpp"
+#include <random>
+#include <stdexcept>
+
+LocalVenue::LocalVenue(LocalVenueConfig config, Executor executor)
+    : config_(config), executor_(std::move(executor)), worker_(&LocalVenue::run, this) {}
+
+LocalVenue::~LocalVenue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+void LocalVenue::submit(const HedgeOrder& order) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(PendingOrder{order, std::chrono::steady_clock::now() + config_.latency});
+    }
+    wake_.notify_one();
+}
+
+bool LocalVenue::poll(std::vector<HedgeAck>& out) {
+    if (!has_acks_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    
+    out.swap(acks_);
+    acks_.clear();
+    has_acks_.store(false, std::memory_order_release);
+    return !out.empty();
+}
+
+void LocalVenue::run() {
+    std::mt19937_64 gen(config_.seed);
+    std::bernoulli_distribution reject(config_.reject_probability);
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        
+        auto due = pending_.front().due;
+        if (wake_.wait_until(lock, due, [this] { return stopping_; })) {
+            return;
+        }
+        
+        HedgeOrder order = pending_.front().order;
+        pending_.pop_front();
+        lock.unlock();
+        
+        HedgeAck ack{order.order_id, HedgeOrderStatus::FILLED, order.quantity};
+        try {
+            if (reject(gen)) {
+                throw std::runtime_error("Order rejected by venue");
+            }
+            if (executor_) {
+                executor_(order);
+            }
+        } catch (const std::exception&) {
+            ack.status = HedgeOrderStatus::REJECTED;
+            ack.filled_quantity = 0.0;
+        }
+        
+        lock.lock();
+        acks_.push_back(ack);
+        has_acks_.store(true, std::memory_order_release);
+    }
+}
+
+AsyncHedgeExecutor::AsyncHedgeExecutor(std::unique_ptr<HedgeVenue> venue)
+    : venue_(std::move(venue)) {
+    if (!venue_) {
+        throw std::invalid_argument("Hedge executor requires a venue");
+    }
+    in_flight_.reserve(64);
+    acks_.reserve(64);
+}
+
+HedgeOrderId AsyncHedgeExecutor::submit(UnderlyingId underlying_id, Quantity quantity, Price hedge_change) {
+    if (quantity == 0.0) {
+        throw std::invalid_argument("Trade quantity must be non-zero");
+    }
+    
+    HedgeOrderId order_id = next_order_id_++;
+    in_flight_.emplace(order_id, InFlightOrder{underlying_id, quantity, hedge_change});
+    pending_hedge_[underlying_id] += hedge_change;
+    
+    try {
+        venue_->submit(HedgeOrder{order_id, underlying_id, quantity});
+    } catch (...) {
+        in_flight_.erase(order_id);
+        pending_hedge_[underlying_id] -= hedge_change;
+        throw;
+    }
+    
+    return order_id;
+}
+
+Price AsyncHedgeExecutor::pending_hedge(UnderlyingId underlying_id) const {
+    auto it = pending_hedge_.find(underlying_id);
+    return (it != pending_hedge_.end()) ? it->second : 0.0;
+}
\ No newline at end of file
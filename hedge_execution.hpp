@@ -0,0 +1,139 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using HedgeOrderId = std::uint64_t;
+
+enum class HedgeOrderStatus { FILLED, REJECTED };
+
+struct HedgeOrder {
+    HedgeOrderId order_id;
+    UnderlyingId underlying_id;
+    Quantity quantity;
+};
+
+struct HedgeAck {
+    HedgeOrderId order_id;
+    HedgeOrderStatus status;
+    Quantity filled_quantity;
+};
+
+class HedgeVenue {
+public:
+    virtual ~HedgeVenue() = default;
+    
+    virtual void submit(const HedgeOrder& order) = 0;
+    virtual bool poll(std::vector<HedgeAck>& out) = 0;
+};
+
+struct LocalVenueConfig {
+    std::chrono::microseconds latency{250};
+    double reject_probability = 0.0;
+    std::uint64_t seed = 1;
+};
+
+class LocalVenue : public HedgeVenue {
+public:
+    using Executor = std::function<void(const HedgeOrder&)>;
+    
+    explicit LocalVenue(LocalVenueConfig config = {}, Executor executor = {});
+    ~LocalVenue() override;
+    
+    LocalVenue(const LocalVenue&) = delete;
+    LocalVenue& operator=(const LocalVenue&) = delete;
+    
+    void submit(const HedgeOrder& order) override;
+    bool poll(std::vector<HedgeAck>& out) override;
+
+private:
+    struct PendingOrder {
+        HedgeOrder order;
+        std::chrono::steady_clock::time_point due;
+    };
+    
+    LocalVenueConfig config_;
+    Executor executor_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<PendingOrder> pending_;
+    std::vector<HedgeAck> acks_;
+    std::atomic<bool> has_acks_{false};
+    bool stopping_ = false;
+    std::thread worker_;
+    
+    void run();
+};
+
+struct HedgeFill {
+    UnderlyingId underlying_id;
+    Quantity quantity;
+    Price hedge_change;
+};
+
+class AsyncHedgeExecutor {
+public:
+    explicit AsyncHedgeExecutor(std::unique_ptr<HedgeVenue> venue);
+    
+    HedgeOrderId submit(UnderlyingId underlying_id, Quantity quantity, Price hedge_change);
+    
+    template <typename OnFill>
+    std::size_t poll(OnFill&& on_fill);
+    
+    Price pending_hedge(UnderlyingId underlying_id) const;
+    std::size_t in_flight() const noexcept { return in_flight_.size(); }
+    std::uint64_t rejected() const noexcept { return rejected_; }
+
+private:
+    struct InFlightOrder {
+        UnderlyingId underlying_id;
+        Quantity quantity;
+        Price hedge_change;
+    };
+    
+    std::unique_ptr<HedgeVenue> venue_;
+    HedgeOrderId next_order_id_ = 1;
+    std::unordered_map<HedgeOrderId, InFlightOrder> in_flight_;
+    DeltaMap pending_hedge_;
+    std::vector<HedgeAck> acks_;
+    std::uint64_t rejected_ = 0;
+};
+
+template <typename OnFill>
+std::size_t AsyncHedgeExecutor::poll(OnFill&& on_fill) {
+    if (!venue_->poll(acks_)) {
+        return 0;
+    }
+    
+    std::size_t applied = 0;
+    for (const HedgeAck& ack : acks_) {
+        auto it = in_flight_.find(ack.order_id);
+        if (it == in_flight_.end()) {
+            continue;
+        }
+        
+        const InFlightOrder& order = it->second;
+        pending_hedge_[order.underlying_id] -= order.hedge_change;
+        
+        if (ack.status == HedgeOrderStatus::FILLED && ack.filled_quantity != 0.0) {
+            Price fraction = ack.filled_quantity / order.quantity;
+            on_fill(HedgeFill{order.underlying_id, ack.filled_quantity, order.hedge_change * fraction});
+            ++applied;
+        } else {
+            ++rejected_;
+        }
+        
+        in_flight_.erase(it);
+    }
+    
+    acks_.clear();
+    return applied;
+}
\ No newline at end of file
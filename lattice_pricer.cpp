@@ -0,0 +1,148 @@
+#include "lattice_pricer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+Price LatticePricer::price(const Option& option, const Underlying& underlying) const {
+    return price_at(option, underlying, underlying.valuation);
+}
+
+Price LatticePricer::price_at(const Option& option, const Underlying& underlying, Price spot) const {
+    if (pruning.enabled && option.steps_until_expiry >= pruning.min_steps) {
+        return price_pruned(option, underlying, spot, pruning.tolerance).price;
+    }
+    return price_full(option, underlying, spot);
+}
+
+Price LatticePricer::price_full(const Option& option, const Underlying& underlying, Price spot) const {
+    int n = option.steps_until_expiry;
+    
+    static thread_local std::vector<Price> tree;
+    tree.resize(n + 1);
+    
+    for (int i = 0; i <= n; ++i) {
+        int up_moves = i;
+        int down_moves = n - i;
+        
+        Price terminal = spot + up_moves * underlying.up_move_step
+                       - down_moves * underlying.down_move_step;
+        terminal = std::max(terminal, 0.0);
+        
+        if (option.option_type == OptionType::CALL) {
+            tree[i] = std::max(terminal - option.strike, 0.0);
+        } else {
+            tree[i] = std::max(static_cast<double>(option.strike) - terminal, 0.0);
+        }
+    }
+    
+    for (int step = n; step > 0; --step) {
+        for (int i = 0; i < step; ++i) {
+            tree[i] = underlying.up_move_probability * tree[i + 1]
+                    + underlying.down_move_probability * tree[i];
+        }
+    }
+    
+    return tree[0];
+}
+
+PrunedLatticeResult LatticePricer::price_pruned(const Option& option, const Underlying& underlying,
+                                               Price spot, Price tolerance) const {
+    int n = option.steps_until_expiry;
+    double p = underlying.up_move_probability;
+    double q = underlying.down_move_probability;
+    
+    double sd = std::sqrt(n * p * q);
+    Price max_payoff = option.option_type == OptionType::CALL
+                     ? std::max(0.0, spot + n * underlying.up_move_step - option.strike)
+                     : static_cast<Price>(option.strike);
+    
+    double k = 3.0;
+    while (2.0 * std::erfc(k / std::sqrt(2.0)) * max_payoff > tolerance && k * sd < n) {
+        k += 0.5;
+    }
+    
+    return price_in_band(option, underlying, spot, k);
+}
+
+PrunedLatticeResult LatticePricer::price_in_band(const Option& option, const Underlying& underlying,
+                                                Price spot, double k) const {
+    int n = option.steps_until_expiry;
+    double p = underlying.up_move_probability;
+    double q = underlying.down_move_probability;
+    Price up = underlying.up_move_step;
+    Price down = underlying.down_move_step;
+    Price strike = option.strike;
+    bool is_call = option.option_type == OptionType::CALL;
+    
+    double sd = std::sqrt(n * p * q);
+    Price max_payoff = is_call ? std::max(0.0, spot + n * up - strike) : strike;
+    Price truncation_error = 2.0 * std::erfc(k / std::sqrt(2.0)) * max_payoff;
+    
+    int half_width = static_cast<int>(std::ceil(k * sd)) + 1;
+    if (2 * half_width + 1 >= n + 1) {
+        return PrunedLatticeResult{price_full(option, underlying, spot), 0.0, k, n + 1};
+    }
+    
+    auto band_lo = [p, half_width](int t) { return std::max(0, static_cast<int>(std::floor(t * p - half_width))); };
+    auto band_hi = [p, half_width](int t) { return std::min(t, static_cast<int>(std::ceil(t * p + half_width))); };
+    auto intrinsic = [=](int t, int i) {
+        Price s = std::max(spot + i * up - (t - i) * down, 0.0);
+        return is_call ? std::max(s - strike, 0.0) : std::max(strike - s, 0.0);
+    };
+    
+    static thread_local std::vector<Price> layer;
+    static thread_local std::vector<Price> next;
+    
+    int lo = band_lo(n);
+    int hi = band_hi(n);
+    layer.resize(hi - lo + 1);
+    for (int i = lo; i <= hi; ++i) {
+        layer[i - lo] = intrinsic(n, i);
+    }
+    
+    for (int t = n; t > 0; --t) {
+        int next_lo = band_lo(t - 1);
+        int next_hi = band_hi(t - 1);
+        next.resize(next_hi - next_lo + 1);
+        
+        auto value = [&](int i) { return (i >= lo && i <= hi) ? layer[i - lo] : intrinsic(t, i); };
+        
+        int inner_lo = std::max(next_lo, lo);
+        int inner_hi = std::min(next_hi, hi - 1);
+        for (int i = next_lo; i < inner_lo; ++i) {
+            next[i - next_lo] = p * value(i + 1) + q * value(i);
+        }
+        const Price* src = layer.data();
+        Price* dst = next.data();
+        for (int i = inner_lo; i <= inner_hi; ++i) {
+            dst[i - next_lo] = p * src[i + 1 - lo] + q * src[i - lo];
+        }
+        for (int i = std::max(inner_hi + 1, next_lo); i <= next_hi; ++i) {
+            next[i - next_lo] = p * value(i + 1) + q * value(i);
+        }
+        
+        layer.swap(next);
+        lo = next_lo;
+        hi = next_hi;
+    }
+    
+    return PrunedLatticeResult{layer[0], truncation_error, k, 2 * half_width + 1};
+}
+
+Greeks LatticePricer::price_and_greeks(const Option& option, const Underlying& underlying) const {
+    Price bump = bump_size(underlying);
+    Price spot = underlying.valuation;
+    
+    Price center = price_at(option, underlying, spot);
+    Price up_price = price_at(option, underlying, spot + bump);
+    Price down_price = price_at(option, underlying, std::max(0.0, spot - bump));
+    
+    Price delta = (up_price - center) / bump;
+    Price gamma = (up_price - 2 * center + down_price) / (bump * bump);
+    
+    return std::make_tuple(center, delta, gamma);
+}
+
+Price LatticePricer::bump_size(const Underlying& underlying) noexcept {
+    return std::min(1.0, underlying.up_move_step * 0.1);
+}
\ No newline at end of file
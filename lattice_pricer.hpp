@@ -0,0 +1,35 @@
+#pragma once
+
+#include "types.hpp"
+#include "option.hpp"
+#include "underlying.hpp"
+
+// Pruning is opt-in: the full lattice is the reference every engine is
+// validated against.
+struct PrunedLatticeConfig {
+    bool enabled = false;
+    Steps min_steps = 512;
+    Price tolerance = 1e-9;
+};
+
+struct PrunedLatticeResult {
+    Price price;
+    Price truncation_error;
+    double k_sigma;
+    int band_width;
+};
+
+struct LatticePricer {
+    PrunedLatticeConfig pruning{};
+    
+    Price price(const Option& option, const Underlying& underlying) const;
+    Price price_at(const Option& option, const Underlying& underlying, Price spot) const;
+    Price price_full(const Option& option, const Underlying& underlying, Price spot) const;
+    PrunedLatticeResult price_pruned(const Option& option, const Underlying& underlying,
+                                     Price spot, Price tolerance) const;
+    PrunedLatticeResult price_in_band(const Option& option, const Underlying& underlying,
+                                      Price spot, double k_sigma) const;
+    Greeks price_and_greeks(const Option& option, const Underlying& underlying) const;
+    
+    static Price bump_size(const Underlying& underlying) noexcept;
+};
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "market_maker.hpp"
+#include "universe_loader.hpp"
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <thread>
 
 void print_separator(std::string_view title) {
     std::cout << "\n" << std::string(60, '=') << "\n";
@@ -35,21 +38,31 @@ void print_bid_ask(const Option& option, const BidAsk& quote) {
 void print_position_summary(MarketMaker& mm) {
     std::cout << "\nPosition Summary:\n";
     std::cout << "Option Positions:\n";
-    for (const auto& [option_id, quantity] : mm.position.option_quantity_by_option_id) {
+    const auto& position = mm.position;
+    for (size_t slot = 0; slot < position.option_slot_count(); ++slot) {
+        int quantity = position.option_quantities[slot];
         if (quantity != 0) {
-            std::cout << "  Option " << option_id << ": " << quantity << " contracts\n";
+            std::cout << "  Option " << position.option_ids[slot] << ": " << quantity << " contracts\n";
         }
     }
     
     std::cout << "Underlying Positions:\n";
-    for (const auto& [underlying_id, quantity] : mm.position.underlying_quantity_by_underlying_id) {
+    for (size_t slot = 0; slot < position.underlying_slot_count(); ++slot) {
+        Quantity quantity = position.underlying_quantity_at(slot);
         if (std::abs(quantity) > 1e-6) {
-            std::cout << "  Underlying " << underlying_id << ": " 
+            std::cout << "  Underlying " << position.underlying_ids[slot] << ": "
                         << std::fixed << std::setprecision(4) << quantity << " shares\n";
         }
     }
 }
 
+void print_cache_stats(const MarketMaker& mm) {
+    const auto& stats = mm.cache_stats();
+    std::cout << "\nGreeks Cache: " << stats.size << "/" << stats.capacity << " entries, "
+                << stats.hits << " hits, " << stats.misses << " misses, "
+                << stats.evictions << " evictions\n";
+}
+
 UnderlyingVector create_underlyings() {
     UnderlyingVector underlyings;
     underlyings.reserve(2);
@@ -72,6 +85,14 @@ OptionVector create_options(const UnderlyingVector& underlyings) {
     return options;
 }
 
+Universe load_universe(const std::string& universe_path) {
+    Universe universe = build_universe(UniverseImage::open(universe_path));
+    if (universe.options.size() < 4) {
+        throw std::runtime_error("Universe '" + universe_path + "' needs at least 4 options for the simulation");
+    }
+    return universe;
+}
+
 UnderlyingVector advance_underlyings(const UnderlyingVector& current_underlyings) {
     UnderlyingVector new_underlyings;
     new_underlyings.reserve(current_underlyings.size());
@@ -109,23 +130,99 @@ void print_market_movement(const UnderlyingVector& old_underlyings,
     }
 }
 
-int main() {
+void settle_hedges(MarketMaker& mm) {
+    if (mm.hedges_in_flight() == 0) {
+        return;
+    }
+    
+    std::cout << "Waiting for " << mm.hedges_in_flight() << " hedge acknowledgment(s)\n";
+    while (mm.hedges_in_flight() > 0) {
+        mm.poll_hedges();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+void save_snapshot(MarketMaker& mm, const std::string& snapshot_path) {
+    if (!snapshot_path.empty()) {
+        settle_hedges(mm);
+        mm.write_snapshot(snapshot_path);
+        std::cout << "Snapshot written to " << snapshot_path << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string snapshot_path;
+    std::string metrics_name;
+    std::string quote_feed_name;
+    std::string engine_name;
+    std::string universe_path;
+    long hedge_latency_us = -1;
+    bool greeks_surfaces = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--snapshot" && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            metrics_name = argv[++i];
+        } else if (arg == "--engine" && i + 1 < argc) {
+            engine_name = argv[++i];
+        } else if (arg == "--universe" && i + 1 < argc) {
+            universe_path = argv[++i];
+        } else if (arg == "--quote-feed" && i + 1 < argc) {
+            quote_feed_name = argv[++i];
+        } else if (arg == "--hedge-latency-us" && i + 1 < argc) {
+            hedge_latency_us = std::stol(argv[++i]);
+        } else if (arg == "--greeks-surfaces") {
+            greeks_surfaces = true;
+        }
+    }
+    
     try {
         print_separator("MORNINGSIDE MARKET MAKER SIMULATION");
 
-        auto underlyings = create_underlyings();
-        auto options = create_options(underlyings);
+        UnderlyingVector underlyings;
+        OptionVector options;
+        if (!universe_path.empty()) {
+            Universe universe = load_universe(universe_path);
+            underlyings = std::move(universe.underlyings);
+            options = std::move(universe.options);
+        } else {
+            underlyings = create_underlyings();
+            options = create_options(underlyings);
+        }
         
         print_underlying_state(underlyings);
         print_option_state(options);
 
         MarketMaker mm{UnderlyingVector(underlyings), OptionVector(options)};
+        if (!engine_name.empty()) {
+            mm.set_pricing_engine(PricingEngineRegistry::with_builtin_engines().create(engine_name));
+        }
+        if (greeks_surfaces) {
+            mm.enable_greeks_surfaces();
+        }
+        if (!metrics_name.empty()) {
+            mm.attach_metrics(metrics_name);
+        }
+        if (!quote_feed_name.empty()) {
+            mm.attach_quote_feed(quote_feed_name);
+        }
+        if (hedge_latency_us >= 0) {
+            LocalVenueConfig venue_config;
+            venue_config.latency = std::chrono::microseconds(hedge_latency_us);
+            mm.attach_hedge_venue(std::make_unique<LocalVenue>(venue_config));
+        }
 
         mm.register_trade_underlying_callback([](UnderlyingId id, Quantity qty) {
             std::cout << "  Trading underlying " << id << ": " 
                         << std::fixed << std::setprecision(4) << qty << " shares\n";
         });
         
+        if (!snapshot_path.empty() && std::ifstream(snapshot_path).good()) {
+            mm.restore_snapshot(snapshot_path);
+            std::cout << "Restored state from " << snapshot_path << "\n";
+        }
+        
         print_separator("INITIAL MARKET MAKING");
         
         std::cout << "Market Maker Quotes:\n";
@@ -160,6 +257,7 @@ int main() {
         print_market_movement(underlyings, new_underlyings);
 
         mm.on_step_advance(std::move(new_underlyings), std::move(new_options));
+        save_snapshot(mm, snapshot_path);
         
         print_separator("NEW QUOTES AFTER MOVEMENT");
 
@@ -181,6 +279,7 @@ int main() {
         print_market_movement(prev_underlyings, final_underlyings);
         
         mm.on_step_advance(std::move(final_underlyings), std::move(final_options));
+        save_snapshot(mm, snapshot_path);
         
         print_separator("FINAL STATE");
         
@@ -194,7 +293,9 @@ int main() {
             print_bid_ask(option, quote);
         }
         
+        settle_hedges(mm);
         print_position_summary(mm);
+        print_cache_stats(mm);
         
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -1,389 +1,497 @@
 #include "market_maker.hpp"
+#include "lattice_pricer.hpp"
+#include "snapshot.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
 
-MarketMaker::MarketMaker(UnderlyingVector underlying_initial_state,
-            OptionVector option_initial_state)
-    : BaseMarketMaker(std::move(underlying_initial_state), std::move(option_initial_state)) {
+EnginePricer::EnginePricer(const Position& position)
+    : position(position), default_engine_(std::make_shared<LatticeEngine>(std::string(PricingEngineRegistry::REFERENCE))) {}
+
+const PricingEnginePtr& EnginePricer::engine_for(OptionId option_id) const noexcept {
+    if (contract_engines.empty()) {
+        return default_engine_;
+    }
     
-    price_cache.reserve(1024);
-    last_underlying_prices.reserve(8);
-    target_deltas.reserve(8);
-    hedge_pos.reserve(8);
-    last_hedge.reserve(8);
+    auto engine_it = contract_engines.find(option_id);
+    return (engine_it != contract_engines.end()) ? engine_it->second : default_engine_;
 }
 
-std::string MarketMaker::cache_key_string(OptionId option_id, Price price) const {
-    std::string key;
-    key.reserve(32);
-    key += std::to_string(option_id);
-    key += "_";
-    key += std::to_string(price);
-    return key;
+void EnginePricer::set_default_engine(PricingEnginePtr engine) {
+    if (!engine) {
+        throw std::invalid_argument("Pricing engine must not be null");
+    }
+    
+    default_engine_ = std::move(engine);
 }
 
-Price MarketMaker::portfolio_value() {
-    Price total = pnl;
-    
-    for (const auto& option_ptr : active_option_state) {
-        const auto& option = *option_ptr;
-        auto it = position.option_quantity_by_option_id.find(option.option_id);
-        if (it != position.option_quantity_by_option_id.end() && it->second != 0) {
-            total += it->second * price_option(option);
-        }
+void EnginePricer::set_contract_engine(OptionId option_id, PricingEnginePtr engine) {
+    if (engine) {
+        contract_engines[option_id] = std::move(engine);
+    } else {
+        contract_engines.erase(option_id);
+    }
+}
+
+void EnginePricer::enable_surfaces(GreeksSurfaceConfig config) {
+    surface_builder = std::make_unique<GreeksSurfaceBuilder>(config);
+}
+
+EnginePricer::SurfaceSlot& EnginePricer::surface_slot(Position::Slot slot) {
+    if (slot >= surface_slots.size()) {
+        surface_slots.resize(slot + 1);
+    }
+    return surface_slots[slot];
+}
+
+bool EnginePricer::surface_usable(const GreeksSurface* surface, const Option& option) const noexcept {
+    return surface && surface->option_id() == option.option_id && surface->covers(option.steps_until_expiry)
+           && surface->engine() == engine_for(option.option_id).get();
+}
+
+void EnginePricer::request_surface(Steps& pending, const Option& option, const Underlying& underlying,
+                                   Steps first_steps) {
+    if (pending != first_steps) {
+        pending = first_steps;
+        surface_builder->request(option, underlying, engine_for(option.option_id), first_steps);
+    }
+}
+
+void EnginePricer::adopt_surfaces() {
+    if (!surface_builder->collect(collected_surfaces)) {
+        return;
     }
     
-    for (const auto& u_ptr : underlying_state) {
-        const auto& u = *u_ptr;
-        auto it = position.underlying_quantity_by_underlying_id.find(u.underlying_id);
-        if (it != position.underlying_quantity_by_underlying_id.end() && it->second != 0) {
-            total += it->second * u.valuation;
+    for (auto& surface : collected_surfaces) {
+        Position::Slot slot = position.find_option_slot(surface->option_id());
+        if (slot == Position::NO_SLOT || slot >= surface_slots.size()) continue;
+        
+        SurfaceSlot& entry = surface_slots[slot];
+        if (surface->first_steps() == entry.current_request) {
+            entry.current = std::move(surface);
+            entry.current_request = 0;
+        } else if (surface->first_steps() == entry.ahead_request) {
+            entry.ahead = std::move(surface);
+            entry.ahead_request = 0;
         }
     }
-    
-    return total;
+    collected_surfaces.clear();
 }
 
-bool MarketMaker::check_risk_limit() {
-    Price curr_value = portfolio_value();
-    if (curr_value < max_loss) {
-        safe_mode = true;
-        return true;
+std::optional<Greeks> EnginePricer::interpolate(Position::Slot slot, const Option& option, const Underlying& underlying) {
+    if (!surface_builder || option.steps_until_expiry <= 0) {
+        return std::nullopt;
     }
     
-    if (safe_mode && curr_value > max_loss * 0.5) {
-        safe_mode = false;
+    adopt_surfaces();
+    
+    SurfaceSlot& entry = surface_slot(slot);
+    Steps steps = option.steps_until_expiry;
+    if (!surface_usable(entry.current.get(), option) && surface_usable(entry.ahead.get(), option)) {
+        entry.current = std::move(entry.ahead);
     }
     
-    return safe_mode;
-}
-
-Price MarketMaker::price_option_from_scratch(const Option& option, const Underlying& underlying) {
-    int n = option.steps_until_expiry;
+    const GreeksSurface* surface = entry.current.get();
+    if (!surface_usable(surface, option)) {
+        request_surface(entry.current_request, option, underlying, steps);
+        return std::nullopt;
+    }
     
-    std::vector<Price> tree;
-    tree.reserve(n + 1);
-    tree.resize(n + 1);
+    if (surface->needs_recentre(underlying.valuation)) {
+        request_surface(entry.current_request, option, underlying, steps);
+    } else if (steps == surface->last_steps() && steps > 1 && !(entry.ahead && entry.ahead->covers(steps - 1))) {
+        request_surface(entry.ahead_request, option, underlying, steps - 1);
+    }
     
-    for (int i = 0; i <= n; ++i) {
-        int up_moves = i;
-        int down_moves = n - i;
-        
-        Price terminal = underlying.valuation + up_moves * underlying.up_move_step 
-                       - down_moves * underlying.down_move_step;
-        terminal = std::max(terminal, 0.0);
-        
-        if (option.option_type == OptionType::CALL) {
-            tree[i] = std::max(terminal - option.strike, 0.0);
-        } else {
-            tree[i] = std::max(static_cast<double>(option.strike) - terminal, 0.0);
-        }
+    return surface->interpolate(steps, underlying.valuation);
+}
+
+bool MarketMaker::HedgeRouter::submit(UnderlyingId u_id, Quantity quantity, Price hedge_change) {
+    if (owner->hedge_executor) {
+        owner->hedge_executor->submit(u_id, quantity, hedge_change);
+        return false;
     }
     
-    for (int step = n; step > 0; --step) {
-        for (int i = 0; i < step; ++i) {
-            tree[i] = underlying.up_move_probability * tree[i + 1] 
-                    + underlying.down_move_probability * tree[i];
+    if (owner->trade_underlying_callback) {
+        owner->trade_underlying_callback(u_id, quantity);
+    }
+    return true;
+}
+
+Price MarketMaker::HedgeRouter::pending_hedge(UnderlyingId u_id) const {
+    return owner->hedge_executor ? owner->hedge_executor->pending_hedge(u_id) : 0.0;
+}
+
+MarketMaker::MarketMaker(UnderlyingVector underlying_initial_state,
+            OptionVector option_initial_state,
+            StrategyParams strategy_params,
+            GreeksCacheConfig cache_config)
+    : BaseMarketMaker(std::move(underlying_initial_state), std::move(option_initial_state)),
+        core(*this, strategy_params, cache_config, EnginePricer(position), DeltaHedger{}, HedgeRouter{this}) {}
+
+MarketMaker::~MarketMaker() {
+    // Fills still on their way would otherwise vanish from the book unnoticed.
+    try {
+        std::size_t abandoned = drain_hedges(std::chrono::milliseconds(500));
+        if (abandoned > 0) {
+            std::cerr << "MarketMaker destroyed with " << abandoned << " hedge order(s) in flight\n";
         }
+    } catch (const std::exception& e) {
+        std::cerr << "MarketMaker destroyed while draining hedges: " << e.what() << "\n";
     }
-    
-    return tree[0];
 }
 
-std::unique_ptr<Underlying> MarketMaker::pump_it_up(const Underlying& underlying, Price bump) const {
-    return std::make_unique<Underlying>(
-        underlying.name, underlying.underlying_id,
-        std::max(0.0, underlying.valuation + bump),
-        underlying.down_move_probability, underlying.down_move_step,
-        underlying.noise_std_dev, underlying.up_move_probability,
-        underlying.up_move_step);
+void MarketMaker::enable_greeks_surfaces(GreeksSurfaceConfig config) {
+    core.pricer().enable_surfaces(config);
 }
 
-Price MarketMaker::calculate_delta(const Option& option, const Underlying& underlying, Price base_price) {
-    Price bump_size = std::min(1.0, underlying.up_move_step * 0.1);
-    
-    auto bumped_underlying = pump_it_up(underlying, bump_size);
-    Price bumped = price_option_from_scratch(option, *bumped_underlying);
-    
-    return (bumped - base_price) / bump_size;
+void MarketMaker::set_pricing_engine(PricingEnginePtr engine) {
+    core.pricer().set_default_engine(std::move(engine));
+    core.reset_greeks();
 }
 
-Price MarketMaker::calculate_gamma(const Option& option, const Underlying& underlying) {
-    Price bump_size = std::min(1.0, underlying.up_move_step * 0.1);
-    
-    Price center = price_option_from_scratch(option, underlying);
-    
-    auto up_u = pump_it_up(underlying, bump_size);
-    Price up_price = price_option_from_scratch(option, *up_u);
-    
-    auto down_u = pump_it_up(underlying, -bump_size);
-    Price down_price = price_option_from_scratch(option, *down_u);
+void MarketMaker::set_pricing_engine(OptionId option_id, PricingEnginePtr engine) {
+    core.pricer().set_contract_engine(option_id, std::move(engine));
+    core.reset_greeks();
+}
+
+const PricingEngine& MarketMaker::pricing_engine(OptionId option_id) const {
+    return *core.pricer().engine_for(option_id);
+}
+
+void MarketMaker::apply_hedge_fill(const HedgeFill& fill) {
+    if (trade_underlying_callback) {
+        trade_underlying_callback(fill.underlying_id, fill.quantity);
+    }
     
-    return (up_price - 2 * center + down_price) / (bump_size * bump_size);
+    core.apply_hedge_fill(fill.underlying_id, fill.quantity, fill.hedge_change);
 }
 
-Greeks MarketMaker::get_greeks(const Option& option, const Underlying& underlying) {
-    Price curr_price = underlying.valuation;
-    std::string key = cache_key_string(option.option_id, curr_price);
+BidAsk MarketMaker::make_market(const Option& option) {
+    ++quote_count;
+    BidAsk quote = core.quote(option);
     
-    auto it = price_cache.find(key);
-    if (it != price_cache.end()) {
-        return it->second;
+    if (quote_publisher) {
+        quote_publisher->publish(option.option_id, std::get<0>(quote), std::get<1>(quote));
     }
     
-    Price price = price_option_from_scratch(option, underlying);
-    Price delta = calculate_delta(option, underlying, price);
-    Price gamma = calculate_gamma(option, underlying);
-    
-    Greeks greeks = std::make_tuple(price, delta, gamma);
-    price_cache.emplace(std::move(key), greeks);
-    return greeks;
+    return quote;
 }
 
-const Underlying* MarketMaker::find_underlying(UnderlyingId u_id) const {
-    auto it = std::find_if(underlying_state.begin(), underlying_state.end(),
-                            [u_id](const UnderlyingPtr& u) { return u->underlying_id == u_id; });
-    return (it != underlying_state.end()) ? it->get() : nullptr;
+Price MarketMaker::price_option(const Option& option) {
+    return core.price_option(option);
 }
 
-Price MarketMaker::portfolio_delta(UnderlyingId u_id) {
-    const Underlying* underlying = find_underlying(u_id);
-    if (!underlying) return 0.0;
+void MarketMaker::on_bid_hit(const Option& option, Price bid_price) {
+    ++fill_count;
+    poll_hedges();
+    core.on_bid_hit(option, bid_price);
+    publish_metrics();
+}
+
+void MarketMaker::on_offer_hit(const Option& option, Price offer_price) {
+    ++fill_count;
+    poll_hedges();
+    core.on_offer_hit(option, offer_price);
+    publish_metrics();
+}
+
+void MarketMaker::on_step_advance(UnderlyingVector new_underlying_state,
+                    OptionVector new_option_state) {
+    advance_state(std::move(new_underlying_state), std::move(new_option_state), 1);
+}
+
+void MarketMaker::advance_state(UnderlyingVector new_underlying_state, OptionVector new_option_state,
+                                std::uint64_t steps) {
+    BaseMarketMaker::on_step_advance(std::move(new_underlying_state), std::move(new_option_state));
+    core.sync_state();
     
-    Price total = 0.0;
+    poll_hedges();
+    core.advance(steps);
     
-    for (const auto& opt_ptr : active_option_state) {
-        const auto& opt = *opt_ptr;
-        if (opt.underlying_id == u_id) {
-            auto pos_it = position.option_quantity_by_option_id.find(opt.option_id);
-            if (pos_it != position.option_quantity_by_option_id.end() && pos_it->second != 0) {
-                auto [price, delta, gamma] = get_greeks(opt, *underlying);
-                total += pos_it->second * delta;
-            }
-        }
+    step_count += steps;
+    publish_metrics();
+}
+
+void MarketMaker::attach_quote_feed(const std::string& shm_name, std::size_t capacity) {
+    quote_publisher = std::make_unique<QuotePublisher>(shm_name, capacity);
+}
+
+void MarketMaker::attach_metrics(const std::string& shm_name) {
+    metrics_publisher = std::make_unique<MetricsPublisher>(shm_name);
+    publish_metrics();
+}
+
+void MarketMaker::on_conflated_update(ConflatedUpdate update) {
+    for (const ExpiryEvent& expiry : update.expiries) {
+        core.record_expiry(expiry.option_id, expiry.underlying_ticks);
     }
     
-    auto hedge_it = hedge_pos.find(u_id);
-    if (hedge_it != hedge_pos.end()) {
-        total -= hedge_it->second;
+    advance_state(std::move(update.underlyings), std::move(update.options), update.steps_elapsed);
+}
+
+void MarketMaker::attach_hedge_venue(std::unique_ptr<HedgeVenue> venue) {
+    if (hedges_in_flight() > 0) {
+        throw std::logic_error("Cannot replace hedge venue with orders in flight");
     }
     
-    return total;
+    hedge_executor = std::make_unique<AsyncHedgeExecutor>(std::move(venue));
 }
 
-void MarketMaker::delta_hedge_post_trade(const Option& option, int q) {
-    const Underlying* underlying = find_underlying(option.underlying_id);
-    if (!underlying) return;
-    
-    auto [price, delta, gamma] = get_greeks(option, *underlying);
-    
-    Price delta_exposure = q * delta;
-    target_deltas[underlying->underlying_id] += delta_exposure;
-    
-    Price net_delta = portfolio_delta(underlying->underlying_id);
+std::size_t MarketMaker::poll_hedges() {
+    if (!hedge_executor) {
+        return 0;
+    }
     
-    if (std::abs(net_delta) > HEDGE_TH) {
-        exec_delta_hedge(underlying->underlying_id, net_delta);
+    return hedge_executor->poll([this](const HedgeFill& fill) { apply_hedge_fill(fill); });
+}
+
+std::size_t MarketMaker::drain_hedges(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (hedges_in_flight() > 0 && std::chrono::steady_clock::now() < deadline) {
+        if (poll_hedges() == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
     }
+    return hedges_in_flight();
 }
 
-void MarketMaker::exec_delta_hedge(UnderlyingId u_id, Price target) {
-    Price current_hedge = hedge_pos[u_id];
-    Price hedge_trade = target - current_hedge;
-    
-    if (std::abs(hedge_trade) < MIN_HEDGE) {
+std::uint64_t MarketMaker::hedge_rejects() const noexcept {
+    std::uint64_t venue_rejects = hedge_executor ? hedge_executor->rejected() : 0;
+    return venue_rejects + core.hedge_reject_count();
+}
+
+void MarketMaker::publish_metrics() {
+    if (!metrics_publisher) {
         return;
     }
     
-    try {
-        if (hedge_trade > 0) {
-            sell_underlying(u_id, std::abs(hedge_trade));
-        } else {
-            buy_underlying(u_id, std::abs(hedge_trade));
-        }
+    const StrategyState& state = core.state();
+    
+    StrategyMetrics metrics{};
+    metrics.step = step_count;
+    metrics.quotes = quote_count;
+    metrics.fills = fill_count;
+    metrics.hedge_trades = core.hedge_trade_count();
+    metrics.hedges_in_flight = hedges_in_flight();
+    metrics.hedge_rejects = hedge_rejects();
+    metrics.pnl = state.pnl;
+    metrics.safe_mode = state.safe_mode ? 1 : 0;
+    
+    const auto& stats = core.cache().stats();
+    metrics.cache_size = stats.size;
+    metrics.cache_hits = stats.hits;
+    metrics.cache_misses = stats.misses;
+    metrics.cache_evictions = stats.evictions;
+    
+    auto lookup = [](const DeltaMap& values, UnderlyingId u_id) {
+        auto it = values.find(u_id);
+        return (it != values.end()) ? it->second : 0.0;
+    };
+    
+    const auto& underlying_slots = core.underlyings_by_slot();
+    std::size_t count = 0;
+    for (size_t slot = 0; slot < underlying_slots.size() && count < METRICS_MAX_UNDERLYINGS; ++slot) {
+        const Underlying* u = underlying_slots[slot];
+        if (!u) continue;
         
-        hedge_pos[u_id] = current_hedge + hedge_trade;
-    } catch (const std::exception&) {
+        UnderlyingMetrics& entry = metrics.underlyings[count++];
+        entry.underlying_id = u->underlying_id;
+        entry.valuation = u->valuation;
+        entry.position = position.underlying_quantity_at(slot);
+        entry.hedge_position = lookup(state.hedge_pos, u->underlying_id);
+        entry.pending_hedge = hedge_executor ? hedge_executor->pending_hedge(u->underlying_id) : 0.0;
+        entry.target_delta = lookup(state.target_deltas, u->underlying_id);
     }
+    metrics.underlying_count = static_cast<std::uint32_t>(count);
+    metrics.publish_time_ns = monotonic_time_ns();
+    
+    metrics_publisher->publish(metrics);
 }
 
-void MarketMaker::rehedge(const UnderlyingVector& new_u_state) {
-    for (const auto& u_ptr : new_u_state) {
-        const auto& u = *u_ptr;
-        UnderlyingId u_id = u.underlying_id;
-        Price cprice = u.valuation;
-        
-        auto last_price_it = last_underlying_prices.find(u_id);
-        Price lprice = (last_price_it != last_underlying_prices.end()) ? last_price_it->second : cprice;
-        
-        Price diff = cprice - lprice;
-        
-        if (std::abs(diff) < GAMMA_SCALP_TH) {
-            continue;
-        }
-        
-        Price net_delta = portfolio_delta(u_id);
-        
-        if (std::abs(net_delta) > HEDGE_TH) {
-            Price hedge_trade = net_delta;
-            
-            try {
-                Price current_hedge = hedge_pos[u_id];
-                
-                if (hedge_trade > 0) {
-                    buy_underlying(u_id, std::abs(hedge_trade));
-                } else {
-                    sell_underlying(u_id, std::abs(hedge_trade));
-                }
-                
-                hedge_pos[u_id] = current_hedge + hedge_trade;
-                
-            } catch (const std::exception&) {
-            }
-        }
-        
-        last_hedge[u_id] = cprice;
+namespace {
+
+template <typename Record>
+void append_records(std::vector<std::byte>& buffer, const std::vector<Record>& records) {
+    size_t offset = buffer.size();
+    buffer.resize(offset + records.size() * sizeof(Record));
+    if (!records.empty()) {
+        std::memcpy(buffer.data() + offset, records.data(), records.size() * sizeof(Record));
     }
 }
 
-BidAsk MarketMaker::make_market(const Option& option) {
-    if (check_risk_limit()) {
-        return std::make_tuple(0.01, 99999999.0);
+std::vector<UnderlyingAmountRecord> amount_records(const std::unordered_map<UnderlyingId, Price>& amounts) {
+    std::vector<UnderlyingAmountRecord> records;
+    records.reserve(amounts.size());
+    for (const auto& [u_id, amount] : amounts) {
+        records.push_back(UnderlyingAmountRecord{u_id, 0, amount});
+    }
+    return records;
+}
+
+template <typename Record>
+const Record* section(const MappedFile& file, size_t& offset, std::uint64_t count) {
+    size_t bytes = count * sizeof(Record);
+    if (count > file.size() / sizeof(Record) || offset + bytes > file.size()) {
+        throw std::runtime_error("Snapshot is truncated");
+    }
+    const Record* records = reinterpret_cast<const Record*>(file.data() + offset);
+    offset += bytes;
+    return records;
+}
+
+void restore_amounts(std::unordered_map<UnderlyingId, Price>& amounts,
+                     const UnderlyingAmountRecord* records, std::uint64_t count) {
+    amounts.clear();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        amounts[records[i].underlying_id] = records[i].amount;
+    }
+}
+
+}
+
+void MarketMaker::write_snapshot(const std::string& path) const {
+    if (hedges_in_flight() > 0) {
+        throw std::logic_error("Cannot snapshot with hedge orders in flight");
     }
     
-    Price fair = price_option(option);
-    
-    auto curr_pos_it = position.option_quantity_by_option_id.find(option.option_id);
-    int curr_pos = (curr_pos_it != position.option_quantity_by_option_id.end()) ? curr_pos_it->second : 0;
-    
-    Price base_spread = std::max(0.01, fair * 0.02);
-    
-    const Underlying* underlying = find_underlying(option.underlying_id);
-    if (!underlying) {
-        return std::make_tuple(0.01, 99999999.0);
+    std::vector<OptionPositionRecord> option_positions;
+    option_positions.reserve(position.option_slot_count());
+    for (size_t slot = 0; slot < position.option_slot_count(); ++slot) {
+        option_positions.push_back(OptionPositionRecord{position.option_ids[slot], position.option_quantities[slot]});
     }
     
-    auto [price, delta, gamma] = get_greeks(option, *underlying);
+    std::vector<UnderlyingLotsRecord> underlying_positions;
+    underlying_positions.reserve(position.underlying_slot_count());
+    for (size_t slot = 0; slot < position.underlying_slot_count(); ++slot) {
+        underlying_positions.push_back(UnderlyingLotsRecord{position.underlying_ids[slot], 0, position.underlying_lots[slot]});
+    }
     
-    Price gamma_adj = std::min(0.5, std::abs(gamma) * underlying->valuation * 0.1);
+    // Cached Greeks are only valid for the engine that produced them. Records
+    // from per-contract engines are left out so the header can name one engine.
+    const EnginePricer& pricer = core.pricer();
+    const StrategyState& state = core.state();
+    std::string_view engine_name = pricer.default_engine().name();
+    bool engine_recorded = engine_name.size() < SNAPSHOT_ENGINE_NAME_SIZE;
+    
+    std::vector<GreeksRecord> greeks;
+    if (engine_recorded) {
+        greeks.reserve(core.cache().size());
+        core.cache().for_each([&pricer, &greeks](const GreeksKey& key, const Greeks& value) {
+            if (pricer.has_contract_engine(key.option_id)) return;
+            auto [price, delta, gamma] = value;
+            greeks.push_back(GreeksRecord{key.option_id, key.steps_until_expiry, key.spot_ticks, price, delta, gamma});
+        });
+    }
     
-    Price time_adj = 1.0;
-    if (option.steps_until_expiry <= 2) {
-        time_adj = 2.0;
-    } else if (option.steps_until_expiry <= 5) {
-        time_adj = 1.3;
+    std::vector<ExpiryRecord> expiries;
+    expiries.reserve(state.expiry_ticks.size());
+    for (const auto& [option_id, ticks] : state.expiry_ticks) {
+        expiries.push_back(ExpiryRecord{option_id, 0, ticks});
     }
     
-    Price spread = base_spread * time_adj * (1 + gamma_adj);
+    auto hedges = amount_records(state.hedge_pos);
+    auto targets = amount_records(state.target_deltas);
+    auto last_prices = amount_records(state.last_underlying_prices);
+    auto last_hedges = amount_records(state.last_hedge);
+    
+    SnapshotHeader header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.pnl = state.pnl;
+    header.safe_mode = state.safe_mode ? 1 : 0;
+    header.option_position_count = option_positions.size();
+    header.underlying_position_count = underlying_positions.size();
+    header.hedge_count = hedges.size();
+    header.target_delta_count = targets.size();
+    header.last_price_count = last_prices.size();
+    header.last_hedge_count = last_hedges.size();
+    header.greeks_count = greeks.size();
+    header.expiry_count = expiries.size();
+    if (engine_recorded) {
+        std::memcpy(header.greeks_engine, engine_name.data(), engine_name.size());
+    }
     
-    Price bid = std::max(0.0, fair - spread / 2);
-    Price ask = fair + spread / 2;
+    std::vector<std::byte> buffer(sizeof(SnapshotHeader));
+    append_records(buffer, option_positions);
+    append_records(buffer, underlying_positions);
+    append_records(buffer, hedges);
+    append_records(buffer, targets);
+    append_records(buffer, last_prices);
+    append_records(buffer, last_hedges);
+    append_records(buffer, greeks);
+    append_records(buffer, expiries);
     
-    if (curr_pos > MAX_POSITIONS) {
-        bid = 0.01;
-    } else if (curr_pos < -MAX_POSITIONS) {
-        ask = ask * 10;
-    }
+    header.total_size = buffer.size();
+    std::memcpy(buffer.data(), &header, sizeof(header));
     
-    return std::make_tuple(bid, ask);
+    write_file_atomically(path, buffer.data(), buffer.size());
 }
 
-Price MarketMaker::price_option(const Option& option) {
-    const Underlying* underlying = find_underlying(option.underlying_id);
-    if (!underlying) {
-        return 0.0;
+void MarketMaker::restore_snapshot(const std::string& path) {
+    MappedFile file(path);
+    if (file.size() < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Snapshot is truncated");
     }
     
-    if (option.steps_until_expiry == 0) {
-        return option.expiry_valuation(underlying->valuation);
+    SnapshotHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC) {
+        throw std::runtime_error("Not a market maker snapshot: " + path);
     }
-    
-    Price curr_price = underlying->valuation;
-    std::string cache_key = cache_key_string(option.option_id, curr_price);
-    
-    auto it = price_cache.find(cache_key);
-    if (it != price_cache.end()) {
-        return std::get<0>(it->second);
+    if (header.version != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version));
     }
-    
-    auto last_price_it = last_underlying_prices.find(underlying->underlying_id);
-    if (last_price_it != last_underlying_prices.end() && last_price_it->second != curr_price) {
-        Price price_diff = std::abs(curr_price - last_price_it->second);
-        
-        if (price_diff < underlying->up_move_step * 0.1) {
-            std::string old_cache_key = cache_key_string(option.option_id, last_price_it->second);
-            auto old_it = price_cache.find(old_cache_key);
-            if (old_it != price_cache.end()) {
-                auto [old_price, delta, gamma] = old_it->second;
-                Price dS = curr_price - last_price_it->second;
-                Price price = old_price + delta * dS + 0.5 * gamma * dS * dS;
-                
-                Price new_delta = calculate_delta(option, *underlying, price);
-                Price new_gamma = calculate_gamma(option, *underlying);
-                
-                price_cache.emplace(std::move(cache_key), std::make_tuple(price, new_delta, new_gamma));
-                return price;
-            }
-        }
+    if (header.total_size != file.size()) {
+        throw std::runtime_error("Snapshot size mismatch");
     }
     
-    Price price = price_option_from_scratch(option, *underlying);
-    Price delta = calculate_delta(option, *underlying, price);
-    Price gamma = calculate_gamma(option, *underlying);
-    price_cache.emplace(std::move(cache_key), std::make_tuple(price, delta, gamma));
-    
-    last_underlying_prices[underlying->underlying_id] = curr_price;
-    
-    return price;
-}
-
-void MarketMaker::on_bid_hit(const Option& option, Price bid_price) {
-    BaseMarketMaker::on_bid_hit(option, bid_price);
-    pnl += bid_price;
-    delta_hedge_post_trade(option, 1);
-}
-
-void MarketMaker::on_offer_hit(const Option& option, Price offer_price) {
-    BaseMarketMaker::on_offer_hit(option, offer_price);
-    pnl -= offer_price;
-    delta_hedge_post_trade(option, -1);
-}
-
-void MarketMaker::on_step_advance(UnderlyingVector new_underlying_state,
-                    OptionVector new_option_state) {
-    BaseMarketMaker::on_step_advance(std::move(new_underlying_state), std::move(new_option_state));
-
-    std::unordered_set<OptionId> active_options;
-    active_options.reserve(active_option_state.size());
-    for (const auto& opt_ptr : active_option_state) {
-        active_options.insert(opt_ptr->option_id);
-    }
-    
-    auto it = price_cache.begin();
-    while (it != price_cache.end()) {
-        const std::string& key = it->first;
-        size_t underscore_pos = key.find('_');
-        if (underscore_pos != std::string::npos) {
-            OptionId opt_id = std::stoi(key.substr(0, underscore_pos));
-            if (active_options.find(opt_id) == active_options.end()) {
-                it = price_cache.erase(it);
-                continue;
-            }
-        }
-        ++it;
+    size_t offset = sizeof(SnapshotHeader);
+    const auto* option_positions = section<OptionPositionRecord>(file, offset, header.option_position_count);
+    const auto* underlying_positions = section<UnderlyingLotsRecord>(file, offset, header.underlying_position_count);
+    const auto* hedges = section<UnderlyingAmountRecord>(file, offset, header.hedge_count);
+    const auto* targets = section<UnderlyingAmountRecord>(file, offset, header.target_delta_count);
+    const auto* last_prices = section<UnderlyingAmountRecord>(file, offset, header.last_price_count);
+    const auto* last_hedges = section<UnderlyingAmountRecord>(file, offset, header.last_hedge_count);
+    const auto* greeks = section<GreeksRecord>(file, offset, header.greeks_count);
+    const auto* expiries = section<ExpiryRecord>(file, offset, header.expiry_count);
+    
+    position = Position();
+    for (std::uint64_t i = 0; i < header.option_position_count; ++i) {
+        position.option_quantities[position.option_slot(option_positions[i].option_id)] = option_positions[i].quantity;
     }
-
-    if (price_cache.size() > 100000) {
-        auto keys_to_remove = price_cache.begin();
-        for (int i = 0; i < 50000 && keys_to_remove != price_cache.end(); ++i) {
-            auto to_remove = keys_to_remove++;
-            price_cache.erase(to_remove);
-        }
+    for (std::uint64_t i = 0; i < header.underlying_position_count; ++i) {
+        position.underlying_lots[position.underlying_slot(underlying_positions[i].underlying_id)] = underlying_positions[i].lots;
     }
     
-    rehedge(underlying_state);
+    StrategyState& state = core.state();
+    restore_amounts(state.hedge_pos, hedges, header.hedge_count);
+    restore_amounts(state.target_deltas, targets, header.target_delta_count);
+    restore_amounts(state.last_underlying_prices, last_prices, header.last_price_count);
+    restore_amounts(state.last_hedge, last_hedges, header.last_hedge_count);
+    
+    std::string_view saved_engine(header.greeks_engine, strnlen(header.greeks_engine, SNAPSHOT_ENGINE_NAME_SIZE));
+    std::uint64_t usable_greeks = (saved_engine == core.pricer().default_engine().name()) ? header.greeks_count : 0;
+    
+    GreeksCache& greeks_cache = core.cache();
+    greeks_cache.clear();
+    for (std::uint64_t i = usable_greeks; i > 0; --i) {
+        const GreeksRecord& record = greeks[i - 1];
+        if (core.pricer().has_contract_engine(record.option_id)) continue;
+        greeks_cache.insert(GreeksKey{record.option_id, record.steps_until_expiry, record.spot_ticks},
+                            std::make_tuple(record.price, record.delta, record.gamma));
+    }
     
-    for (const auto& u_ptr : underlying_state) {
-        last_underlying_prices[u_ptr->underlying_id] = u_ptr->valuation;
+    state.expiry_ticks.clear();
+    for (std::uint64_t i = 0; i < header.expiry_count; ++i) {
+        state.expiry_ticks[expiries[i].option_id] = expiries[i].underlying_ticks;
     }
+    
+    state.pnl = header.pnl;
+    state.safe_mode = header.safe_mode != 0;
+    
+    core.rebuild_slots();
 }
\ No newline at end of file
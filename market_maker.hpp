@@ -1,42 +1,98 @@
 #pragma once
 
 #include "base_market_maker.hpp"
-#include <unordered_set>
+#include "conflation.hpp"
+#include "greeks_cache.hpp"
+#include "greeks_surface.hpp"
+#include "hedge_execution.hpp"
+#include "market_maker_core.hpp"
+#include "metrics.hpp"
+#include "pricing_engine.hpp"
+#include "quote_feed.hpp"
+#include "strategy_params.hpp"
+#include <chrono>
 #include <memory>
 
+// Prices with the default engine or a per-contract override. Once surfaces
+// are enabled it also serves interpolated Greeks built in the background for
+// the options being quoted, queueing the next block of expiry steps before
+// the current one runs out.
+class EnginePricer {
+public:
+    explicit EnginePricer(const Position& position);
+    
+    Greeks price_and_greeks(const Option& option, const Underlying& underlying) const {
+        return engine_for(option.option_id)->price_and_greeks(option, underlying);
+    }
+    
+    std::optional<Greeks> interpolate(Position::Slot slot, const Option& option, const Underlying& underlying);
+    
+    const PricingEnginePtr& engine_for(OptionId option_id) const noexcept;
+    const PricingEngine& default_engine() const noexcept { return *default_engine_; }
+    bool has_contract_engine(OptionId option_id) const { return contract_engines.count(option_id) != 0; }
+    void set_default_engine(PricingEnginePtr engine);
+    void set_contract_engine(OptionId option_id, PricingEnginePtr engine);
+    
+    void enable_surfaces(GreeksSurfaceConfig config);
+
+private:
+    struct SurfaceSlot {
+        GreeksSurfacePtr current;
+        GreeksSurfacePtr ahead;
+        Steps current_request = 0;
+        Steps ahead_request = 0;
+    };
+    
+    const Position& position;
+    PricingEnginePtr default_engine_;
+    std::unordered_map<OptionId, PricingEnginePtr> contract_engines;
+    std::unique_ptr<GreeksSurfaceBuilder> surface_builder;
+    std::vector<SurfaceSlot> surface_slots;
+    std::vector<GreeksSurfacePtr> collected_surfaces;
+    
+    SurfaceSlot& surface_slot(Position::Slot slot);
+    bool surface_usable(const GreeksSurface* surface, const Option& option) const noexcept;
+    void request_surface(Steps& pending, const Option& option, const Underlying& underlying, Steps first_steps);
+    void adopt_surfaces();
+};
+
 class MarketMaker : public BaseMarketMaker {
 private:
-    PriceCache price_cache;
-    std::unordered_map<UnderlyingId, Price> last_underlying_prices;
-    DeltaMap target_deltas;
-    DeltaMap hedge_pos;
-    std::unordered_map<UnderlyingId, Price> last_hedge;
-    
-    static constexpr Price MIN_HEDGE = 0.05;
-    static constexpr Price HEDGE_TH = 0.03;
-    static constexpr Price GAMMA_SCALP_TH = 0.005;
-    
-    Price pnl = 0.0;
-    static constexpr Price max_loss = -50000.0;
-    bool safe_mode = false;
-    
-    std::string cache_key_string(OptionId option_id, Price price) const;
-    Price portfolio_value();
-    bool check_risk_limit();
-    Price price_option_from_scratch(const Option& option, const Underlying& underlying);
-    std::unique_ptr<Underlying> pump_it_up(const Underlying& underlying, Price bump) const;
-    Price calculate_delta(const Option& option, const Underlying& underlying, Price base_price);
-    Price calculate_gamma(const Option& option, const Underlying& underlying);
-    Greeks get_greeks(const Option& option, const Underlying& underlying);
-    const Underlying* find_underlying(UnderlyingId u_id) const;
-    Price portfolio_delta(UnderlyingId u_id);
-    void delta_hedge_post_trade(const Option& option, int q);
-    void exec_delta_hedge(UnderlyingId u_id, Price target);
-    void rehedge(const UnderlyingVector& new_u_state);
+    // Sends hedges to the attached venue, or fills them on the spot through
+    // the registered trade callback when there is none.
+    struct HedgeRouter {
+        MarketMaker* owner;
+        
+        bool submit(UnderlyingId u_id, Quantity quantity, Price hedge_change);
+        Price pending_hedge(UnderlyingId u_id) const;
+    };
+    
+    using Core = MarketMakerCore<EnginePricer, DeltaHedger, HedgeRouter>;
     
+    std::unique_ptr<AsyncHedgeExecutor> hedge_executor;
+    Core core;
+    
+    std::unique_ptr<MetricsPublisher> metrics_publisher;
+    std::unique_ptr<QuotePublisher> quote_publisher;
+    std::uint64_t step_count = 0;
+    std::uint64_t quote_count = 0;
+    std::uint64_t fill_count = 0;
+    
+    void apply_hedge_fill(const HedgeFill& fill);
+    void advance_state(UnderlyingVector new_underlying_state, OptionVector new_option_state,
+                       std::uint64_t steps);
+    void publish_metrics();
+
 public:
     MarketMaker(UnderlyingVector underlying_initial_state,
-                OptionVector option_initial_state);
+                OptionVector option_initial_state,
+                StrategyParams strategy_params = {},
+                GreeksCacheConfig cache_config = {});
+    
+    ~MarketMaker() override;
+    
+    MarketMaker(MarketMaker&&) = delete;
+    MarketMaker& operator=(MarketMaker&&) = delete;
     
     BidAsk make_market(const Option& option) override;
     Price price_option(const Option& option) override;
@@ -44,4 +100,28 @@ public:
     void on_offer_hit(const Option& option, Price offer_price) override;
     void on_step_advance(UnderlyingVector new_underlying_state,
                         OptionVector new_option_state) override;
-};
\ No newline at end of file
+    void on_conflated_update(ConflatedUpdate update);
+    
+    const GreeksCacheStats& cache_stats() const noexcept { return core.cache().stats(); }
+    const StrategyParams& strategy_params() const noexcept { return core.strategy_params(); }
+    Price mark_to_market() { return core.mark_to_market(); }
+    bool in_safe_mode() const noexcept { return core.state().safe_mode; }
+    
+    void enable_greeks_surfaces(GreeksSurfaceConfig config = {});
+    
+    void set_pricing_engine(PricingEnginePtr engine);
+    void set_pricing_engine(OptionId option_id, PricingEnginePtr engine);
+    const PricingEngine& pricing_engine(OptionId option_id) const;
+    
+    void attach_metrics(const std::string& shm_name);
+    void attach_quote_feed(const std::string& shm_name, std::size_t capacity = 4096);
+    
+    void attach_hedge_venue(std::unique_ptr<HedgeVenue> venue);
+    std::size_t poll_hedges();
+    std::size_t hedges_in_flight() const noexcept { return hedge_executor ? hedge_executor->in_flight() : 0; }
+    std::size_t drain_hedges(std::chrono::milliseconds timeout);
+    std::uint64_t hedge_rejects() const noexcept;
+    
+    void write_snapshot(const std::string& path) const;
+    void restore_snapshot(const std::string& path);
+};
@@ -0,0 +1,511 @@
+#pragma once
+
+#include "base_market_maker.hpp"
+#include "greeks_cache.hpp"
+#include "lattice_pricer.hpp"
+#include "strategy_params.hpp"
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Everything the strategy carries between steps apart from the position book.
+struct StrategyState {
+    Price pnl = 0.0;
+    bool safe_mode = false;
+    std::unordered_map<UnderlyingId, Price> last_underlying_prices;
+    DeltaMap target_deltas;
+    DeltaMap hedge_pos;
+    std::unordered_map<UnderlyingId, Price> last_hedge;
+    std::unordered_map<OptionId, Ticks> expiry_ticks;
+};
+
+// A pricer may serve interpolated Greeks ahead of the cache through
+// interpolate(slot, option, underlying). Plain pricers such as LatticePricer
+// only price from scratch.
+template <typename Pricer, typename = void>
+struct interpolates_greeks : std::false_type {};
+
+template <typename Pricer>
+struct interpolates_greeks<Pricer, std::void_t<decltype(std::declval<Pricer&>().interpolate(
+        Position::Slot{}, std::declval<const Option&>(), std::declval<const Underlying&>()))>>
+    : std::true_type {};
+
+// Quoting, pricing, risk and hedging shared by every market maker. It trades
+// against a MarketState owned by the caller. An ExecutionSink's submit returns
+// true when the hedge filled on the spot, and the core books it. A sink that
+// hands orders off returns false, covers them in pending_hedge and reports
+// each fill later through apply_hedge_fill.
+template <typename Pricer, typename Hedger, typename ExecutionSink>
+class MarketMakerCore {
+public:
+    MarketMakerCore(MarketState& market_state,
+                    StrategyParams strategy_params,
+                    GreeksCacheConfig cache_config,
+                    Pricer pricer,
+                    Hedger hedger,
+                    ExecutionSink sink)
+        :   market(market_state),
+            greeks_cache(cache_config),
+            params(strategy_params),
+            pricer_(std::move(pricer)),
+            hedger_(std::move(hedger)),
+            sink_(std::move(sink)) {
+        
+        state_.last_underlying_prices.reserve(8);
+        state_.target_deltas.reserve(8);
+        state_.hedge_pos.reserve(8);
+        state_.last_hedge.reserve(8);
+        
+        for (const auto& u_ptr : market.underlying_state) {
+            state_.last_underlying_prices.emplace(u_ptr->underlying_id, u_ptr->valuation);
+        }
+        
+        market.position.reserve(market.active_option_state.size(), market.underlying_state.size());
+        option_slots.reserve(market.active_option_state.size());
+        underlying_slots.reserve(market.underlying_state.size());
+        assign_slots();
+    }
+    
+    MarketMakerCore(const MarketMakerCore&) = delete;
+    MarketMakerCore& operator=(const MarketMakerCore&) = delete;
+    
+    BidAsk quote(const Option& option) {
+        if (check_risk_limit()) {
+            return std::make_tuple(0.01, 99999999.0);
+        }
+        
+        OptionSlot* slot = find_option_slot(option);
+        Price fair = price_at_slot(option, slot);
+        
+        const Underlying* underlying = option_underlying(slot, option);
+        if (!underlying) {
+            return std::make_tuple(0.01, 99999999.0);
+        }
+        
+        auto [price, delta, gamma] = get_greeks(option, *underlying, slot);
+        
+        return quote_around(params, fair, gamma, underlying->valuation, option.steps_until_expiry, slot_quantity(slot));
+    }
+    
+    Price price_option(const Option& option) {
+        return price_at_slot(option, find_option_slot(option));
+    }
+    
+    void on_bid_hit(const Option& option, Price bid_price) {
+        market.position.add_option_quantity(option.option_id, 1);
+        state_.pnl += bid_price;
+        delta_hedge_post_trade(option, 1);
+    }
+    
+    void on_offer_hit(const Option& option, Price offer_price) {
+        market.position.add_option_quantity(option.option_id, -1);
+        state_.pnl -= offer_price;
+        delta_hedge_post_trade(option, -1);
+    }
+    
+    // Picks up a new underlying and option state already stored in the book.
+    void sync_state() {
+        assign_slots();
+        prune_expiries();
+    }
+    
+    void advance(std::uint64_t steps) {
+        for (std::uint64_t i = 0; i < steps; ++i) {
+            greeks_cache.advance_epoch();
+        }
+        
+        rehedge();
+        
+        for (const auto& u_ptr : market.underlying_state) {
+            state_.last_underlying_prices[u_ptr->underlying_id] = u_ptr->valuation;
+        }
+    }
+    
+    void record_expiry(OptionId option_id, Ticks underlying_ticks) {
+        state_.expiry_ticks.try_emplace(option_id, underlying_ticks);
+    }
+    
+    void apply_hedge_fill(UnderlyingId u_id, Quantity quantity, Price hedge_change) {
+        market.position.add_underlying_quantity(u_id, quantity);
+        state_.hedge_pos[u_id] += hedge_change;
+        ++hedge_trades;
+    }
+    
+    // Drops every cached Greek, for when the pricer behind them changes.
+    void reset_greeks() {
+        greeks_cache.clear();
+        assign_slots();
+    }
+    
+    // Rebuilds the slot tables after the position book was replaced.
+    void rebuild_slots() {
+        option_slots.clear();
+        underlying_slots.clear();
+        assign_slots();
+    }
+    
+    Price mark_to_market() { return portfolio_value(); }
+    
+    Price hedge_position(UnderlyingId u_id) const {
+        auto hedge_it = state_.hedge_pos.find(u_id);
+        Price hedge = (hedge_it != state_.hedge_pos.end()) ? hedge_it->second : 0.0;
+        return hedge + sink_.pending_hedge(u_id);
+    }
+    
+    const Underlying* find_underlying(UnderlyingId u_id) const {
+        Position::Slot u_slot = market.position.find_underlying_slot(u_id);
+        return (u_slot < underlying_slots.size()) ? underlying_slots[u_slot] : nullptr;
+    }
+    
+    const std::vector<const Underlying*>& underlyings_by_slot() const noexcept { return underlying_slots; }
+    
+    StrategyState& state() noexcept { return state_; }
+    const StrategyState& state() const noexcept { return state_; }
+    GreeksCache& cache() noexcept { return greeks_cache; }
+    const GreeksCache& cache() const noexcept { return greeks_cache; }
+    const StrategyParams& strategy_params() const noexcept { return params; }
+    std::uint64_t hedge_trade_count() const noexcept { return hedge_trades; }
+    std::uint64_t hedge_reject_count() const noexcept { return hedge_rejects; }
+    
+    Pricer& pricer() noexcept { return pricer_; }
+    const Pricer& pricer() const noexcept { return pricer_; }
+    Hedger& hedger() noexcept { return hedger_; }
+    ExecutionSink& execution_sink() noexcept { return sink_; }
+
+private:
+    struct OptionSlot {
+        const Option* option = nullptr;
+        Position::Slot underlying_slot = Position::NO_SLOT;
+        Ticks greeks_spot = 0;
+        Greeks greeks{};
+        Steps greeks_steps = 0;
+        bool greeks_valid = false;
+    };
+    
+    MarketState& market;
+    GreeksCache greeks_cache;
+    std::vector<OptionSlot> option_slots;
+    std::vector<Position::Slot> state_slots;
+    std::vector<const Underlying*> underlying_slots;
+    StrategyState state_;
+    StrategyParams params;
+    Pricer pricer_;
+    Hedger hedger_;
+    ExecutionSink sink_;
+    std::uint64_t hedge_trades = 0;
+    std::uint64_t hedge_rejects = 0;
+    
+    void assign_slots() {
+        Position& position = market.position;
+        
+        for (auto& u : underlying_slots) {
+            u = nullptr;
+        }
+        for (auto& slot : option_slots) {
+            slot.option = nullptr;
+            slot.greeks_valid = false;
+        }
+        
+        for (const auto& u_ptr : market.underlying_state) {
+            Position::Slot u_slot = position.underlying_slot(u_ptr->underlying_id);
+            if (u_slot >= underlying_slots.size()) {
+                underlying_slots.resize(u_slot + 1, nullptr);
+            }
+            underlying_slots[u_slot] = u_ptr.get();
+        }
+        
+        // Option states usually arrive in the same order every step, so the slot
+        // found for each position in the state is tried before the id lookup.
+        const OptionVector& options = market.active_option_state;
+        state_slots.resize(options.size(), Position::NO_SLOT);
+        for (size_t i = 0; i < options.size(); ++i) {
+            const Option& option = *options[i];
+            Position::Slot slot = state_slots[i];
+            if (slot >= position.option_slot_count() || position.option_ids[slot] != option.option_id) {
+                slot = position.option_slot(option.option_id);
+                state_slots[i] = slot;
+            }
+            if (slot >= option_slots.size()) {
+                option_slots.resize(slot + 1);
+            }
+            
+            OptionSlot& entry = option_slots[slot];
+            entry.option = &option;
+            if (entry.underlying_slot == Position::NO_SLOT) {
+                entry.underlying_slot = position.underlying_slot(option.underlying_id);
+            }
+        }
+        
+        if (position.underlying_slot_count() > underlying_slots.size()) {
+            underlying_slots.resize(position.underlying_slot_count(), nullptr);
+        }
+    }
+    
+    // Settlement prices only come from record_expiry. Without one, an expired
+    // option is valued at the current underlying price.
+    void prune_expiries() {
+        auto& expiry_ticks = state_.expiry_ticks;
+        for (auto it = expiry_ticks.begin(); it != expiry_ticks.end();) {
+            Position::Slot slot = market.position.find_option_slot(it->first);
+            bool active = slot < option_slots.size() && option_slots[slot].option;
+            it = active ? std::next(it) : expiry_ticks.erase(it);
+        }
+    }
+    
+    OptionSlot* find_option_slot(const Option& option) {
+        Position::Slot slot = market.position.find_option_slot(option.option_id);
+        if (slot == Position::NO_SLOT || slot >= option_slots.size()) {
+            return nullptr;
+        }
+        return &option_slots[slot];
+    }
+    
+    const Underlying* option_underlying(const OptionSlot* slot, const Option& option) const {
+        if (slot && slot->underlying_slot < underlying_slots.size()) {
+            return underlying_slots[slot->underlying_slot];
+        }
+        return find_underlying(option.underlying_id);
+    }
+    
+    Position::Slot slot_index(const OptionSlot* slot) const noexcept {
+        return static_cast<Position::Slot>(slot - option_slots.data());
+    }
+    
+    int slot_quantity(const OptionSlot* slot) const noexcept {
+        return slot ? market.position.option_quantities[slot_index(slot)] : 0;
+    }
+    
+    const Greeks* cached_slot_greeks(const OptionSlot* slot, const Option& option, Ticks spot) const {
+        if (slot && slot->greeks_valid && slot->greeks_steps == option.steps_until_expiry
+            && slot->greeks_spot == spot) {
+            return &slot->greeks;
+        }
+        return nullptr;
+    }
+    
+    void store_slot_greeks(OptionSlot* slot, const Option& option, Ticks spot, const Greeks& greeks) {
+        if (!slot) return;
+        slot->greeks_valid = true;
+        slot->greeks_steps = option.steps_until_expiry;
+        slot->greeks_spot = spot;
+        slot->greeks = greeks;
+    }
+    
+    std::optional<Greeks> interpolated_greeks(const OptionSlot* slot, const Option& option, const Underlying& underlying) {
+        if constexpr (interpolates_greeks<Pricer>::value) {
+            if (slot) {
+                return pricer_.interpolate(slot_index(slot), option, underlying);
+            }
+        }
+        return std::nullopt;
+    }
+    
+    Price portfolio_value() {
+        Price total = state_.pnl;
+        
+        const auto& option_quantities = market.position.option_quantities;
+        for (size_t slot = 0; slot < option_slots.size(); ++slot) {
+            const Option* option = option_slots[slot].option;
+            if (option && option_quantities[slot] != 0) {
+                total += option_quantities[slot] * price_at_slot(*option, &option_slots[slot]);
+            }
+        }
+        
+        const auto& underlying_lots = market.position.underlying_lots;
+        for (size_t slot = 0; slot < underlying_slots.size(); ++slot) {
+            const Underlying* u = underlying_slots[slot];
+            if (u && underlying_lots[slot] != 0) {
+                total += from_lots(underlying_lots[slot]) * u->valuation;
+            }
+        }
+        
+        return total;
+    }
+    
+    bool check_risk_limit() {
+        Price curr_value = portfolio_value();
+        if (curr_value < params.max_loss) {
+            state_.safe_mode = true;
+            return true;
+        }
+        
+        if (state_.safe_mode && curr_value > params.max_loss * params.recovery_fraction) {
+            state_.safe_mode = false;
+        }
+        
+        return state_.safe_mode;
+    }
+    
+    Price price_at_slot(const Option& option, OptionSlot* slot) {
+        const Underlying* underlying = option_underlying(slot, option);
+        if (!underlying) {
+            return 0.0;
+        }
+        
+        if (option.steps_until_expiry == 0) {
+            auto expiry_it = state_.expiry_ticks.find(option.option_id);
+            Ticks settlement = (expiry_it != state_.expiry_ticks.end()) ? expiry_it->second : underlying->valuation_ticks;
+            return from_ticks(option.expiry_valuation_ticks(settlement));
+        }
+        
+        Price curr_price = underlying->valuation;
+        Ticks curr_ticks = underlying->valuation_ticks;
+        if (const Greeks* cached = cached_slot_greeks(slot, option, curr_ticks)) {
+            return std::get<0>(*cached);
+        }
+        
+        if (auto interpolated = interpolated_greeks(slot, option, *underlying)) {
+            store_slot_greeks(slot, option, curr_ticks, *interpolated);
+            return std::get<0>(*interpolated);
+        }
+        
+        GreeksKey cache_key{option.option_id, option.steps_until_expiry, curr_ticks};
+        
+        if (const Greeks* cached = greeks_cache.find(cache_key)) {
+            store_slot_greeks(slot, option, curr_ticks, *cached);
+            return std::get<0>(*cached);
+        }
+        
+        auto& last_prices = state_.last_underlying_prices;
+        auto last_price_it = last_prices.find(underlying->underlying_id);
+        if (last_price_it != last_prices.end() && last_price_it->second != curr_price) {
+            Price price_diff = std::abs(curr_price - last_price_it->second);
+            
+            if (price_diff < underlying->up_move_step * 0.1) {
+                GreeksKey old_cache_key{option.option_id, option.steps_until_expiry, to_ticks(last_price_it->second)};
+                if (const Greeks* old_greeks = greeks_cache.find(old_cache_key)) {
+                    auto [old_price, delta, gamma] = *old_greeks;
+                    Price dS = curr_price - last_price_it->second;
+                    Price price = old_price + delta * dS + 0.5 * gamma * dS * dS;
+                    
+                    // Delta and gamma are recomputed at the new spot, with delta
+                    // taken from the bumped price against the Taylor price.
+                    auto [center, center_delta, new_gamma] = pricer_.price_and_greeks(option, *underlying);
+                    Price new_delta = center_delta + (center - price) / LatticePricer::bump_size(*underlying);
+                    
+                    Greeks greeks = std::make_tuple(price, new_delta, new_gamma);
+                    greeks_cache.insert(cache_key, greeks);
+                    store_slot_greeks(slot, option, curr_ticks, greeks);
+                    return price;
+                }
+            }
+        }
+        
+        Greeks greeks = pricer_.price_and_greeks(option, *underlying);
+        greeks_cache.insert(cache_key, greeks);
+        store_slot_greeks(slot, option, curr_ticks, greeks);
+        
+        last_prices[underlying->underlying_id] = curr_price;
+        
+        return std::get<0>(greeks);
+    }
+    
+    Greeks get_greeks(const Option& option, const Underlying& underlying, OptionSlot* slot) {
+        Ticks curr_ticks = underlying.valuation_ticks;
+        if (const Greeks* cached = cached_slot_greeks(slot, option, curr_ticks)) {
+            return *cached;
+        }
+        
+        if (auto interpolated = interpolated_greeks(slot, option, underlying)) {
+            store_slot_greeks(slot, option, curr_ticks, *interpolated);
+            return *interpolated;
+        }
+        
+        GreeksKey key{option.option_id, option.steps_until_expiry, curr_ticks};
+        
+        if (const Greeks* cached = greeks_cache.find(key)) {
+            store_slot_greeks(slot, option, curr_ticks, *cached);
+            return *cached;
+        }
+        
+        Greeks greeks = pricer_.price_and_greeks(option, underlying);
+        greeks_cache.insert(key, greeks);
+        store_slot_greeks(slot, option, curr_ticks, greeks);
+        return greeks;
+    }
+    
+    Price portfolio_delta(UnderlyingId u_id) {
+        Position::Slot u_slot = market.position.find_underlying_slot(u_id);
+        if (u_slot == Position::NO_SLOT || u_slot >= underlying_slots.size()) return 0.0;
+        
+        const Underlying* underlying = underlying_slots[u_slot];
+        if (!underlying) return 0.0;
+        
+        Price total = 0.0;
+        
+        const auto& option_quantities = market.position.option_quantities;
+        for (size_t slot = 0; slot < option_slots.size(); ++slot) {
+            OptionSlot& entry = option_slots[slot];
+            if (entry.option && entry.underlying_slot == u_slot && option_quantities[slot] != 0) {
+                auto [price, delta, gamma] = get_greeks(*entry.option, *underlying, &entry);
+                total += option_quantities[slot] * delta;
+            }
+        }
+        
+        total -= hedge_position(u_id);
+        
+        return total;
+    }
+    
+    void submit_hedge(UnderlyingId u_id, Quantity quantity, Price hedge_change) {
+        if (sink_.submit(u_id, quantity, hedge_change)) {
+            apply_hedge_fill(u_id, quantity, hedge_change);
+        }
+    }
+    
+    void delta_hedge_post_trade(const Option& option, int q) {
+        OptionSlot* slot = find_option_slot(option);
+        const Underlying* underlying = option_underlying(slot, option);
+        if (!underlying) return;
+        
+        auto [price, delta, gamma] = get_greeks(option, *underlying, slot);
+        
+        Price delta_exposure = q * delta;
+        state_.target_deltas[underlying->underlying_id] += delta_exposure;
+        
+        UnderlyingId u_id = underlying->underlying_id;
+        Price net_delta = portfolio_delta(u_id);
+        Price hedge_trade = hedger_.fill_hedge(params, net_delta, hedge_position(u_id));
+        
+        if (hedge_trade != 0.0) {
+            try {
+                submit_hedge(u_id, -hedge_trade, hedge_trade);
+            } catch (const std::exception&) {
+                ++hedge_rejects;
+            }
+        }
+    }
+    
+    void rehedge() {
+        for (const auto& u_ptr : market.underlying_state) {
+            const auto& u = *u_ptr;
+            UnderlyingId u_id = u.underlying_id;
+            Price cprice = u.valuation;
+            
+            auto last_price_it = state_.last_underlying_prices.find(u_id);
+            Price lprice = (last_price_it != state_.last_underlying_prices.end()) ? last_price_it->second : cprice;
+            
+            Price diff = cprice - lprice;
+            
+            if (!hedger_.rehedge_due(params, diff)) {
+                continue;
+            }
+            
+            Price hedge_trade = hedger_.step_hedge(params, portfolio_delta(u_id));
+            
+            if (hedge_trade != 0.0) {
+                try {
+                    submit_hedge(u_id, hedge_trade, hedge_trade);
+                } catch (const std::exception&) {
+                    ++hedge_rejects;
+                }
+            }
+            
+            state_.last_hedge[u_id] = cprice;
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "metrics.hpp"
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+MetricsPublisher::MetricsPublisher(const std::string& name)
+    : region(SharedMemoryRegion::create(name, sizeof(MetricsRegion))),
+        layout(new (region.data()) MetricsRegion) {
+    
+    layout->magic = METRICS_MAGIC;
+    layout->version = METRICS_VERSION;
+    layout->sequence.store(0, std::memory_order_relaxed);
+    for (auto& word : layout->words) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void MetricsPublisher::publish(const StrategyMetrics& metrics) noexcept {
+    std::uint64_t words[MetricsRegion::WORDS];
+    std::memcpy(words, &metrics, sizeof(metrics));
+    
+    std::uint64_t seq = layout->sequence.load(std::memory_order_relaxed);
+    layout->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    for (std::size_t i = 0; i < MetricsRegion::WORDS; ++i) {
+        layout->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    
+    layout->sequence.store(seq + 2, std::memory_order_release);
+}
+
+MetricsReader::MetricsReader(const std::string& name)
+    : region(SharedMemoryRegion::open(name)),
+        layout(static_cast<const MetricsRegion*>(region.data())) {
+    
+    if (region.size() != sizeof(MetricsRegion)) {
+        throw std::runtime_error("Metrics region '" + name + "' is " + std::to_string(region.size())
+                                 + " bytes, expected " + std::to_string(sizeof(MetricsRegion)));
+    }
+    if (layout->magic != METRICS_MAGIC || layout->version != METRICS_VERSION) {
+        throw std::runtime_error("Unsupported metrics region '" + name + "'");
+    }
+}
+
+bool MetricsReader::read(StrategyMetrics& out, int max_attempts) const noexcept {
+    std::uint64_t words[MetricsRegion::WORDS];
+    
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+        std::uint64_t before = layout->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        
+        for (std::size_t i = 0; i < MetricsRegion::WORDS; ++i) {
+            words[i] = layout->words[i].load(std::memory_order_relaxed);
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (layout->sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&out, words, sizeof(out));
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+std::int64_t monotonic_time_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
\ No newline at end of file
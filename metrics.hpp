@@ -0,0 +1,77 @@
+#pragma once
+
+#include "types.hpp"
+#include "shm_region.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+constexpr std::uint32_t METRICS_MAGIC = 0x4D4D4D54;
+constexpr std::uint32_t METRICS_VERSION = 2;
+constexpr std::size_t METRICS_MAX_UNDERLYINGS = 64;
+
+struct UnderlyingMetrics {
+    UnderlyingId underlying_id;
+    std::int32_t reserved;
+    double valuation;
+    double position;
+    double hedge_position;
+    double pending_hedge;
+    double target_delta;
+};
+
+struct StrategyMetrics {
+    std::uint64_t step;
+    std::uint64_t quotes;
+    std::uint64_t fills;
+    std::uint64_t hedge_trades;
+    std::uint64_t hedges_in_flight;
+    std::uint64_t hedge_rejects;
+    std::int64_t publish_time_ns;
+    double pnl;
+    std::uint32_t safe_mode;
+    std::uint32_t underlying_count;
+    std::uint64_t cache_size;
+    std::uint64_t cache_hits;
+    std::uint64_t cache_misses;
+    std::uint64_t cache_evictions;
+    UnderlyingMetrics underlyings[METRICS_MAX_UNDERLYINGS];
+};
+
+static_assert(std::is_trivially_copyable_v<StrategyMetrics>);
+static_assert(sizeof(StrategyMetrics) % sizeof(std::uint64_t) == 0);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Metrics atomics are shared across processes and must be lock-free");
+
+struct MetricsRegion {
+    static constexpr std::size_t WORDS = sizeof(StrategyMetrics) / sizeof(std::uint64_t);
+    
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> words[WORDS];
+};
+
+class MetricsPublisher {
+public:
+    explicit MetricsPublisher(const std::string& name);
+    
+    void publish(const StrategyMetrics& metrics) noexcept;
+
+private:
+    SharedMemoryRegion region;
+    MetricsRegion* layout;
+};
+
+class MetricsReader {
+public:
+    explicit MetricsReader(const std::string& name);
+    
+    bool read(StrategyMetrics& out, int max_attempts = 64) const noexcept;
+
+private:
+    SharedMemoryRegion region;
+    const MetricsRegion* layout;
+};
+
+std::int64_t monotonic_time_ns() noexcept;
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "metrics.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+void print_metrics(const StrategyMetrics& m) {
+    std::cout << "step " << m.step << " | quotes " << m.quotes << " | fills " << m.fills
+                << " | hedges " << m.hedge_trades << " (" << m.hedges_in_flight << " in flight, "
+                << m.hedge_rejects << " rejected) | pnl " << std::fixed << std::setprecision(2) << m.pnl
+                << " | safe_mode " << (m.safe_mode ? "ON" : "off") << "\n";
+    std::cout << "  cache " << m.cache_size << " entries, " << m.cache_hits << " hits, "
+                << m.cache_misses << " misses, " << m.cache_evictions << " evictions\n";
+    
+    for (std::uint32_t i = 0; i < m.underlying_count && i < METRICS_MAX_UNDERLYINGS; ++i) {
+        const auto& u = m.underlyings[i];
+        std::cout << "  underlying " << u.underlying_id << ": $" << std::setprecision(2) << u.valuation
+                    << " pos " << std::setprecision(4) << u.position
+                    << " hedge " << u.hedge_position
+                    << " pending " << u.pending_hedge
+                    << " target delta " << u.target_delta << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <shm-name> [interval-ms] [count]\n";
+        return 1;
+    }
+    
+    int interval_ms = argc > 2 ? std::stoi(argv[2]) : 1000;
+    int count = argc > 3 ? std::stoi(argv[3]) : 0;
+    
+    try {
+        MetricsReader reader(argv[1]);
+        StrategyMetrics metrics{};
+        
+        for (int i = 0; count == 0 || i < count; ++i) {
+            if (reader.read(metrics)) {
+                std::int64_t age_us = (monotonic_time_ns() - metrics.publish_time_ns) / 1000;
+                std::cout << "[age " << age_us << "us] ";
+                print_metrics(metrics);
+            } else {
+                std::cout << "(writer busy, retrying)\n";
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -3,9 +3,13 @@
 #include <algorithm>
 
 Option::Option(OptionId id, OptionType type, Steps steps, Strike s, 
-        UnderlyingId u_id, std::string u_name)
+        UnderlyingId u_id, std::string_view u_name)
+    : Option(id, type, steps, s, u_id, UnderlyingName(u_name)) {}
+
+Option::Option(OptionId id, OptionType type, Steps steps, Strike s, 
+        UnderlyingId u_id, UnderlyingName u_name)
     : option_id(id), option_type(type), steps_until_expiry(steps),
-        strike(s), underlying_id(u_id), underlying_name(std::move(u_name)) {
+        strike(s), underlying_id(u_id), underlying_name(u_name) {
     
     if (steps_until_expiry < 0) {
         throw std::invalid_argument("Steps until expiry must be non-negative");
@@ -43,6 +47,13 @@ Price Option::expiry_valuation(Price underlying_valuation) const noexcept {
     return std::max(0.0, static_cast<double>(strike) - underlying_valuation);
 }
 
+Ticks Option::expiry_valuation_ticks(Ticks underlying_ticks) const noexcept {
+    if (option_type == OptionType::CALL) {
+        return std::max<Ticks>(0, underlying_ticks - strike_ticks());
+    }
+    return std::max<Ticks>(0, strike_ticks() - underlying_ticks);
+}
+
 std::string Option::to_string() const {
     std::string result;
     result.reserve(64);
@@ -51,7 +62,7 @@ std::string Option::to_string() const {
     result += " (";
     result += std::to_string(steps_until_expiry);
     result += "s ";
-    result += underlying_name;
+    result += underlying_name.view();
     result += " ";
     result += std::to_string(strike);
     result += to_string_view(option_type);
@@ -10,10 +10,13 @@ struct Option {
     Steps steps_until_expiry;
     Strike strike;
     UnderlyingId underlying_id;
-    std::string underlying_name;
+    UnderlyingName underlying_name;
 
     Option(OptionId id, OptionType type, Steps steps, Strike s, 
-            UnderlyingId u_id, std::string u_name);
+            UnderlyingId u_id, std::string_view u_name);
+    
+    Option(OptionId id, OptionType type, Steps steps, Strike s, 
+            UnderlyingId u_id, UnderlyingName u_name);
 
     Option(const Option&) = default;
     Option(Option&&) noexcept = default;
@@ -32,6 +35,9 @@ struct Option {
     bool contract_matches(const Option& other) const noexcept;
     
     Price expiry_valuation(Price underlying_valuation) const noexcept;
+    Ticks expiry_valuation_ticks(Ticks underlying_ticks) const noexcept;
+    
+    Ticks strike_ticks() const noexcept { return static_cast<Ticks>(strike) * TICKS_PER_UNIT; }
     
     std::string to_string() const;
     
@@ -0,0 +1,89 @@
+#include "sweep.hpp"
+#include "option.hpp"
+#include "underlying.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+UnderlyingVector create_underlyings() {
+    UnderlyingVector underlyings;
+    underlyings.emplace_back(std::make_shared<Underlying>("CULIONS", 1, 150.0, 0.5, 2.0, 0.1, 0.5, 2.0));
+    underlyings.emplace_back(std::make_shared<Underlying>("SEAS", 2, 200.0, 0.5, 3.0, 0.2, 0.5, 3.0));
+    return underlyings;
+}
+
+OptionVector create_options(const UnderlyingVector& underlyings, Steps expiry) {
+    OptionVector options;
+    OptionId next_id = 1001;
+    for (const auto& u_ptr : underlyings) {
+        Strike atm = static_cast<Strike>(u_ptr->valuation);
+        for (int offset : {-4, 0, 4}) {
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::CALL, expiry, atm + offset));
+            options.emplace_back(Option::from_underlying(*u_ptr, next_id++, OptionType::PUT, expiry, atm + offset));
+        }
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    int path_count = argc > 1 ? std::stoi(argv[1]) : 16;
+    int step_count = argc > 2 ? std::stoi(argv[2]) : 20;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::stoi(argv[3])) : 0;
+    
+    try {
+        auto underlyings = create_underlyings();
+        // Options expire one step after the last simulated step, so every contract
+        // passes through the mid- and near-expiry spread bands during the run.
+        auto paths = PathSet::generate(underlyings, create_options(underlyings, step_count),
+                                       path_count, step_count, 20240601);
+        
+        ParameterGrid grid;
+        grid.min_hedge = {0.01, 0.05, 0.2};
+        grid.hedge_threshold = {0.01, 0.03, 0.1};
+        grid.gamma_scalp_threshold = {0.001, 0.005, 0.02};
+        grid.max_loss = {-50000.0, -500.0, -100.0};
+        grid.base_spread = {0.01, 0.02, 0.04};
+        grid.near_expiry_multiplier = {1.5, 2.0, 3.0};
+        grid.mid_expiry_multiplier = {1.0, 1.3, 1.6};
+        auto combinations = grid.expand();
+        
+        std::cout << "Sweeping " << combinations.size() << " parameter sets over " << path_count
+                    << " paths x " << step_count << " steps (" << paths.memory_bytes() << " bytes of paths)\n";
+        
+        auto start = std::chrono::steady_clock::now();
+        auto results = run_sweep(paths, combinations, SweepConfig{threads});
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        std::sort(results.begin(), results.end(),
+                  [](const SweepResult& a, const SweepResult& b) { return a.mean_pnl > b.mean_pnl; });
+        
+        std::cout << std::setw(8) << "min_hdg" << std::setw(8) << "hdg_th" << std::setw(9) << "gamma_th"
+                    << std::setw(10) << "max_loss" << std::setw(8) << "spread" << std::setw(7) << "near" << std::setw(7) << "mid"
+                    << std::setw(12) << "mean_pnl" << std::setw(12) << "worst_pnl"
+                    << std::setw(12) << "hedge_cost" << std::setw(12) << "drawdown"
+                    << std::setw(8) << "fills" << std::setw(8) << "hedges" << "\n";
+        
+        for (const auto& r : results) {
+            const auto& p = r.params;
+            std::cout << std::fixed << std::setprecision(3)
+                        << std::setw(8) << p.min_hedge << std::setw(8) << p.hedge_threshold
+                        << std::setw(9) << p.gamma_scalp_threshold
+                        << std::setprecision(0) << std::setw(10) << p.max_loss
+                        << std::setprecision(3) << std::setw(8) << p.base_spread
+                        << std::setprecision(1) << std::setw(7) << p.near_expiry_multiplier
+                        << std::setw(7) << p.mid_expiry_multiplier
+                        << std::setprecision(2) << std::setw(12) << r.mean_pnl << std::setw(12) << r.worst_pnl
+                        << std::setw(12) << r.mean_hedge_cost << std::setw(12) << r.max_drawdown
+                        << std::setw(8) << r.fills << std::setw(8) << r.hedge_trades << "\n";
+        }
+        
+        std::cout << "Evaluated " << combinations.size() << " parameter sets in "
+                    << std::setprecision(2) << seconds << "s\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -1,16 +1,107 @@
 #pragma once
 
 #include "types.hpp"
-#include <cmath>
+#include <utility>
+
+// Id-to-slot table with open addressing. Ids are never removed, so a lookup is
+// one probe run over two flat arrays and an insert allocates nothing until the
+// table has to grow.
+template <typename Id>
+class SlotIndex {
+public:
+    using Slot = std::size_t;
+    static constexpr Slot NO_SLOT = static_cast<Slot>(-1);
+    
+    void reserve(std::size_t count) {
+        if (count * 2 > slots.size()) {
+            rehash(count * 2);
+        }
+    }
+    
+    std::pair<Slot, bool> try_emplace(Id id, Slot slot) {
+        if ((count + 1) * 2 > slots.size()) {
+            rehash((count + 1) * 2);
+        }
+        std::size_t i = bucket(id);
+        for (; slots[i] != NO_SLOT; i = (i + 1) & mask) {
+            if (ids[i] == id) {
+                return {slots[i], false};
+            }
+        }
+        ids[i] = id;
+        slots[i] = slot;
+        ++count;
+        return {slot, true};
+    }
+    
+    Slot find(Id id) const noexcept {
+        if (count == 0) {
+            return NO_SLOT;
+        }
+        for (std::size_t i = bucket(id); slots[i] != NO_SLOT; i = (i + 1) & mask) {
+            if (ids[i] == id) {
+                return slots[i];
+            }
+        }
+        return NO_SLOT;
+    }
+
+private:
+    std::vector<Id> ids;
+    std::vector<Slot> slots;
+    std::size_t mask = 0;
+    std::size_t count = 0;
+    int bits = 0;
+    
+    // Ids are mostly issued in runs, so the low bits pick the bucket and keep
+    // consecutive ids in neighbouring cache lines; the folded high bits stop
+    // ids that differ only above the table size from sharing one run.
+    std::size_t bucket(Id id) const noexcept {
+        auto key = static_cast<std::uint64_t>(id);
+        return static_cast<std::size_t>(key ^ (key >> bits) ^ (key >> (2 * bits))) & mask;
+    }
+    
+    void rehash(std::size_t minimum) {
+        std::size_t capacity = 16;
+        bits = 4;
+        while (capacity < minimum) {
+            capacity *= 2;
+            ++bits;
+        }
+        
+        std::vector<Id> old_ids = std::exchange(ids, std::vector<Id>(capacity));
+        std::vector<Slot> old_slots = std::exchange(slots, std::vector<Slot>(capacity, NO_SLOT));
+        mask = capacity - 1;
+        for (std::size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_slots[i] != NO_SLOT) {
+                std::size_t j = bucket(old_ids[i]);
+                while (slots[j] != NO_SLOT) {
+                    j = (j + 1) & mask;
+                }
+                ids[j] = old_ids[i];
+                slots[j] = old_slots[i];
+            }
+        }
+    }
+};
 
 class Position {
 public:
-    OptionQuantityMap option_quantity_by_option_id;
-    UnderlyingQuantityMap underlying_quantity_by_underlying_id;
+    using Slot = std::size_t;
+    static constexpr Slot NO_SLOT = SlotIndex<OptionId>::NO_SLOT;
+    
+    std::vector<OptionId> option_ids;
+    std::vector<int> option_quantities;
+    std::vector<UnderlyingId> underlying_ids;
+    std::vector<Lots> underlying_lots;
     
     Position() {
-        option_quantity_by_option_id.reserve(16);
-        underlying_quantity_by_underlying_id.reserve(8);
+        option_ids.reserve(16);
+        option_quantities.reserve(16);
+        underlying_ids.reserve(8);
+        underlying_lots.reserve(8);
+        option_slot_by_id.reserve(16);
+        underlying_slot_by_id.reserve(8);
     }
 
     Position(const Position&) = default;
@@ -19,12 +110,72 @@ public:
     Position& operator=(const Position&) = default;
     Position& operator=(Position&&) noexcept = default;
     
+    void reserve(std::size_t options, std::size_t underlyings) {
+        option_ids.reserve(options);
+        option_quantities.reserve(options);
+        underlying_ids.reserve(underlyings);
+        underlying_lots.reserve(underlyings);
+        option_slot_by_id.reserve(options);
+        underlying_slot_by_id.reserve(underlyings);
+    }
+    
+    Slot option_slot(OptionId option_id) {
+        auto [slot, inserted] = option_slot_by_id.try_emplace(option_id, option_ids.size());
+        if (inserted) {
+            option_ids.push_back(option_id);
+            option_quantities.push_back(0);
+        }
+        return slot;
+    }
+    
+    Slot underlying_slot(UnderlyingId underlying_id) {
+        auto [slot, inserted] = underlying_slot_by_id.try_emplace(underlying_id, underlying_ids.size());
+        if (inserted) {
+            underlying_ids.push_back(underlying_id);
+            underlying_lots.push_back(0);
+        }
+        return slot;
+    }
+    
+    Slot find_option_slot(OptionId option_id) const {
+        return option_slot_by_id.find(option_id);
+    }
+    
+    Slot find_underlying_slot(UnderlyingId underlying_id) const {
+        return underlying_slot_by_id.find(underlying_id);
+    }
+    
+    int option_quantity(OptionId option_id) const {
+        Slot slot = find_option_slot(option_id);
+        return (slot != NO_SLOT) ? option_quantities[slot] : 0;
+    }
+    
+    Quantity underlying_quantity(UnderlyingId underlying_id) const {
+        Slot slot = find_underlying_slot(underlying_id);
+        return (slot != NO_SLOT) ? from_lots(underlying_lots[slot]) : 0.0;
+    }
+    
+    Quantity underlying_quantity_at(Slot slot) const noexcept {
+        return from_lots(underlying_lots[slot]);
+    }
+    
+    std::size_t option_slot_count() const noexcept {
+        return option_ids.size();
+    }
+    
+    std::size_t underlying_slot_count() const noexcept {
+        return underlying_ids.size();
+    }
+    
     void add_option_quantity(OptionId option_id, int quantity) {
-        option_quantity_by_option_id[option_id] += quantity;
+        option_quantities[option_slot(option_id)] += quantity;
     }
     
     void add_underlying_quantity(UnderlyingId underlying_id, Quantity quantity) {
-        quantity = std::round(quantity * 100.0) / 100.0;
-        underlying_quantity_by_underlying_id[underlying_id] += quantity;
+        underlying_lots[underlying_slot(underlying_id)] += to_lots(quantity);
     }
+
+private:
+    SlotIndex<OptionId> option_slot_by_id;
+    SlotIndex<UnderlyingId> underlying_slot_by_id;
 };
\ No newline at end of file
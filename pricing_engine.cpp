@@ -0,0 +1,121 @@
+#include "pricing_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+LatticeEngine::LatticeEngine(std::string name, LatticePricer pricer)
+    : name_(std::move(name)), pricer_(pricer) {}
+
+Greeks LatticeEngine::price_and_greeks(const Option& option, const Underlying& underlying) const {
+    return pricer_.price_and_greeks(option, underlying);
+}
+
+PricingEngineRegistry PricingEngineRegistry::with_builtin_engines() {
+    PricingEngineRegistry registry;
+    
+    registry.add("lattice", [] {
+        LatticePricer pricer;
+        pricer.pruning.enabled = true;
+        return std::make_shared<LatticeEngine>("lattice", pricer);
+    });
+    
+    registry.add(std::string(REFERENCE), [] {
+        return std::make_shared<LatticeEngine>(std::string(REFERENCE));
+    });
+    
+    registry.add("lattice-pruned", [] {
+        LatticePricer pricer;
+        pricer.pruning.enabled = true;
+        pricer.pruning.min_steps = 0;
+        return std::make_shared<LatticeEngine>("lattice-pruned", pricer);
+    });
+    
+    return registry;
+}
+
+void PricingEngineRegistry::add(const std::string& name, PricingEngineFactory factory) {
+    if (!factory) {
+        throw std::invalid_argument("Pricing engine factory must be callable");
+    }
+    factories[name] = std::move(factory);
+}
+
+PricingEnginePtr PricingEngineRegistry::create(const std::string& name) const {
+    auto it = factories.find(name);
+    if (it == factories.end()) {
+        throw std::invalid_argument("Unknown pricing engine '" + name + "'");
+    }
+    return it->second();
+}
+
+std::vector<std::string> PricingEngineRegistry::names() const {
+    std::vector<std::string> result;
+    result.reserve(factories.size());
+    for (const auto& [name, factory] : factories) {
+        result.push_back(name);
+    }
+    return result;
+}
+
+std::vector<ValidationContract> random_contracts(std::size_t count, std::uint64_t seed, Steps max_steps) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<> spot_dist(20.0, 500.0);
+    std::uniform_real_distribution<> up_prob_dist(0.3, 0.7);
+    std::uniform_real_distribution<> step_fraction(0.001, 0.02);
+    std::uniform_real_distribution<> moneyness(0.8, 1.2);
+    std::uniform_int_distribution<Steps> steps_dist(1, max_steps);
+    std::bernoulli_distribution is_call(0.5);
+    
+    std::vector<ValidationContract> contracts;
+    contracts.reserve(count);
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        Price spot = std::round(spot_dist(gen) * TICKS_PER_UNIT) / TICKS_PER_UNIT;
+        Probability up_prob = up_prob_dist(gen);
+        Probability down_prob = 1.0 - up_prob;
+        Price up_step = spot * step_fraction(gen);
+        Price down_step = up_prob * up_step / down_prob;
+        
+        UnderlyingId underlying_id = static_cast<UnderlyingId>(i + 1);
+        Underlying underlying("VALID", underlying_id, spot, down_prob, down_step, 0.0, up_prob, up_step);
+        
+        Strike strike = static_cast<Strike>(std::max(1.0, std::round(spot * moneyness(gen))));
+        OptionType type = is_call(gen) ? OptionType::CALL : OptionType::PUT;
+        Option option(static_cast<OptionId>(i + 1), type, steps_dist(gen), strike, underlying_id, underlying.name);
+        
+        contracts.push_back(ValidationContract{std::move(option), std::move(underlying)});
+    }
+    
+    return contracts;
+}
+
+EngineValidation validate_engine(const PricingEngine& reference, const PricingEngine& candidate,
+                                 const std::vector<ValidationContract>& contracts) {
+    using Clock = std::chrono::steady_clock;
+    
+    EngineValidation result;
+    result.contracts = contracts.size();
+    
+    for (const auto& contract : contracts) {
+        auto start = Clock::now();
+        Greeks expected = reference.price_and_greeks(contract.option, contract.underlying);
+        auto mid = Clock::now();
+        Greeks actual = candidate.price_and_greeks(contract.option, contract.underlying);
+        auto end = Clock::now();
+        
+        result.reference_ns += std::chrono::duration<double, std::nano>(mid - start).count();
+        result.candidate_ns += std::chrono::duration<double, std::nano>(end - mid).count();
+        
+        Price price_error = std::abs(std::get<0>(actual) - std::get<0>(expected));
+        if (price_error > result.max_price_error || !std::isfinite(price_error)) {
+            result.max_price_error = price_error;
+            result.worst_contract = contract.option.option_id;
+        }
+        result.max_delta_error = std::max(result.max_delta_error, std::abs(std::get<1>(actual) - std::get<1>(expected)));
+        result.max_gamma_error = std::max(result.max_gamma_error, std::abs(std::get<2>(actual) - std::get<2>(expected)));
+    }
+    
+    return result;
+}
\ No newline at end of file
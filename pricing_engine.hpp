@@ -0,0 +1,72 @@
+#pragma once
+
+#include "types.hpp"
+#include "lattice_pricer.hpp"
+#include <functional>
+#include <map>
+#include <string>
+
+// Engines are shared across threads: surfaces are built on a worker thread,
+// so price_and_greeks must be safe to call concurrently.
+class PricingEngine {
+public:
+    virtual ~PricingEngine() = default;
+    
+    virtual Greeks price_and_greeks(const Option& option, const Underlying& underlying) const = 0;
+    virtual std::string_view name() const noexcept = 0;
+};
+
+using PricingEnginePtr = std::shared_ptr<const PricingEngine>;
+
+class LatticeEngine : public PricingEngine {
+public:
+    explicit LatticeEngine(std::string name, LatticePricer pricer = {});
+    
+    Greeks price_and_greeks(const Option& option, const Underlying& underlying) const override;
+    std::string_view name() const noexcept override { return name_; }
+    
+    const LatticePricer& pricer() const noexcept { return pricer_; }
+
+private:
+    std::string name_;
+    LatticePricer pricer_;
+};
+
+using PricingEngineFactory = std::function<PricingEnginePtr()>;
+
+class PricingEngineRegistry {
+public:
+    static constexpr std::string_view REFERENCE = "lattice-full";
+    
+    static PricingEngineRegistry with_builtin_engines();
+    
+    void add(const std::string& name, PricingEngineFactory factory);
+    PricingEnginePtr create(const std::string& name) const;
+    bool contains(const std::string& name) const { return factories.count(name) != 0; }
+    std::vector<std::string> names() const;
+
+private:
+    std::map<std::string, PricingEngineFactory> factories;
+};
+
+struct ValidationContract {
+    Option option;
+    Underlying underlying;
+};
+
+struct EngineValidation {
+    std::size_t contracts = 0;
+    Price max_price_error = 0.0;
+    Price max_delta_error = 0.0;
+    Price max_gamma_error = 0.0;
+    OptionId worst_contract = 0;
+    double reference_ns = 0.0;
+    double candidate_ns = 0.0;
+    
+    double speedup() const noexcept { return candidate_ns > 0.0 ? reference_ns / candidate_ns : 0.0; }
+};
+
+std::vector<ValidationContract> random_contracts(std::size_t count, std::uint64_t seed,
+                                                 Steps max_steps = 2000);
+EngineValidation validate_engine(const PricingEngine& reference, const PricingEngine& candidate,
+                                 const std::vector<ValidationContract>& contracts);
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "quote_feed.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+std::size_t validated_capacity(std::size_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        throw std::invalid_argument("Quote feed capacity must be a power of two");
+    }
+    return capacity;
+}
+
+std::size_t slots_offset() {
+    return (sizeof(QuoteFeedHeader) + alignof(QuoteSlot) - 1) / alignof(QuoteSlot) * alignof(QuoteSlot);
+}
+
+// Reads the capacity once and checks it against the mapping before anything
+// indexes the ring with it.
+std::uint64_t mapped_capacity(const SharedMemoryRegion& region, const std::string& name) {
+    if (region.size() < slots_offset()) {
+        throw std::runtime_error("Quote feed '" + name + "' is too small for its header");
+    }
+    
+    const auto* header = static_cast<const QuoteFeedHeader*>(region.data());
+    if (header->magic != QUOTE_FEED_MAGIC || header->version != QUOTE_FEED_VERSION) {
+        throw std::runtime_error("Unsupported quote feed '" + name + "'");
+    }
+    
+    std::uint64_t capacity = header->capacity;
+    std::size_t slots_mapped = (region.size() - slots_offset()) / sizeof(QuoteSlot);
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || capacity > slots_mapped) {
+        throw std::runtime_error("Quote feed '" + name + "' claims " + std::to_string(capacity) + " slots, which is not"
+                                 + " a power of two within the " + std::to_string(slots_mapped) + " it maps");
+    }
+    return capacity;
+}
+
+}
+
+QuotePublisher::QuotePublisher(const std::string& name, std::size_t capacity)
+    : region(SharedMemoryRegion::create(name, slots_offset() + validated_capacity(capacity) * sizeof(QuoteSlot))),
+        header(new (region.data()) QuoteFeedHeader),
+        slots(reinterpret_cast<QuoteSlot*>(static_cast<std::byte*>(region.data()) + slots_offset())),
+        mask_(capacity - 1) {
+    
+    for (std::size_t i = 0; i < capacity; ++i) {
+        QuoteSlot* slot = new (&slots[i]) QuoteSlot;
+        slot->version.store(0, std::memory_order_relaxed);
+        for (auto& word : slot->words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    header->magic = QUOTE_FEED_MAGIC;
+    header->version = QUOTE_FEED_VERSION;
+    header->capacity = capacity;
+    header->head.store(0, std::memory_order_release);
+}
+
+void QuotePublisher::publish(OptionId option_id, Price bid, Price ask) noexcept {
+    write_slot(QuoteRecord{option_id, 0, bid, ask, 0, monotonic_time_ns()});
+    header->head.store(next_sequence_ - 1, std::memory_order_release);
+}
+
+void QuotePublisher::publish(const QuoteRecord* records, std::size_t count) noexcept {
+    std::int64_t now = monotonic_time_ns();
+    for (std::size_t i = 0; i < count; ++i) {
+        QuoteRecord record = records[i];
+        record.timestamp_ns = now;
+        write_slot(record);
+    }
+    header->head.store(next_sequence_ - 1, std::memory_order_release);
+}
+
+void QuotePublisher::write_slot(const QuoteRecord& record) noexcept {
+    std::uint64_t sequence = next_sequence_++;
+    QuoteSlot& slot = slots[sequence & mask_];
+    
+    std::uint64_t words[QuoteSlot::WORDS];
+    std::memcpy(words, &record, sizeof(record));
+    words[offsetof(QuoteRecord, sequence) / sizeof(std::uint64_t)] = sequence;
+    
+    slot.version.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    for (std::size_t i = 0; i < QuoteSlot::WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    
+    slot.version.store(2 * sequence, std::memory_order_release);
+}
+
+QuoteReader::QuoteReader(const std::string& name, bool from_oldest)
+    : region(SharedMemoryRegion::open(name)),
+        header(static_cast<const QuoteFeedHeader*>(region.data())),
+        slots(reinterpret_cast<const QuoteSlot*>(static_cast<const std::byte*>(region.data()) + slots_offset())),
+        capacity_(mapped_capacity(region, name)) {
+    
+    std::uint64_t head = header->head.load(std::memory_order_acquire);
+    if (!from_oldest) {
+        cursor_ = head + 1;
+    } else if (head > capacity_) {
+        cursor_ = head - capacity_ + 1;
+    }
+}
+
+std::size_t QuoteReader::poll(QuoteRecord* out, std::size_t max_records) noexcept {
+    std::uint64_t head = header->head.load(std::memory_order_acquire);
+    std::size_t count = 0;
+    
+    while (count < max_records && cursor_ <= head) {
+        if (head - cursor_ >= capacity_) {
+            skip_to(head - capacity_ + 1);
+        }
+        
+        const QuoteSlot& slot = slots[cursor_ & (capacity_ - 1)];
+        std::uint64_t expected = 2 * cursor_;
+        std::uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before != expected) {
+            head = header->head.load(std::memory_order_acquire);
+            skip_to(oldest_available(head));
+            continue;
+        }
+        
+        std::uint64_t words[QuoteSlot::WORDS];
+        for (std::size_t i = 0; i < QuoteSlot::WORDS; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != expected) {
+            head = header->head.load(std::memory_order_acquire);
+            skip_to(oldest_available(head));
+            continue;
+        }
+        
+        std::memcpy(&out[count++], words, sizeof(QuoteRecord));
+        ++cursor_;
+    }
+    
+    return count;
+}
+
+std::uint64_t QuoteReader::oldest_available(std::uint64_t head) const noexcept {
+    std::uint64_t oldest = (head >= capacity_) ? head - capacity_ + 1 : 1;
+    return std::max(oldest, cursor_ + 1);
+}
+
+void QuoteReader::skip_to(std::uint64_t sequence) noexcept {
+    if (sequence > cursor_) {
+        lost_ += sequence - cursor_;
+        cursor_ = sequence;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "types.hpp"
+#include "shm_region.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+constexpr std::uint32_t QUOTE_FEED_MAGIC = 0x46514D4D;
+constexpr std::uint32_t QUOTE_FEED_VERSION = 1;
+
+struct QuoteRecord {
+    OptionId option_id;
+    std::int32_t reserved;
+    double bid;
+    double ask;
+    std::uint64_t sequence;
+    std::int64_t timestamp_ns;
+};
+
+static_assert(std::is_trivially_copyable_v<QuoteRecord>);
+static_assert(sizeof(QuoteRecord) % sizeof(std::uint64_t) == 0);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Quote feed atomics are shared across processes and must be lock-free");
+
+struct alignas(64) QuoteSlot {
+    static constexpr std::size_t WORDS = sizeof(QuoteRecord) / sizeof(std::uint64_t);
+    
+    std::atomic<std::uint64_t> version;
+    std::atomic<std::uint64_t> words[WORDS];
+};
+
+struct QuoteFeedHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head;
+};
+
+class QuotePublisher {
+public:
+    QuotePublisher(const std::string& name, std::size_t capacity = 4096);
+    
+    void publish(OptionId option_id, Price bid, Price ask) noexcept;
+    void publish(const QuoteRecord* records, std::size_t count) noexcept;
+    
+    std::uint64_t published() const noexcept { return next_sequence_ - 1; }
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    SharedMemoryRegion region;
+    QuoteFeedHeader* header;
+    QuoteSlot* slots;
+    std::uint64_t mask_;
+    std::uint64_t next_sequence_ = 1;
+    
+    void write_slot(const QuoteRecord& record) noexcept;
+};
+
+class QuoteReader {
+public:
+    explicit QuoteReader(const std::string& name, bool from_oldest = false);
+    
+    std::size_t poll(QuoteRecord* out, std::size_t max_records) noexcept;
+    
+    std::uint64_t cursor() const noexcept { return cursor_; }
+    std::uint64_t lost() const noexcept { return lost_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    SharedMemoryRegion region;
+    const QuoteFeedHeader* header;
+    const QuoteSlot* slots;
+    std::uint64_t capacity_;
+    std::uint64_t cursor_ = 1;
+    std::uint64_t lost_ = 0;
+    
+    std::uint64_t oldest_available(std::uint64_t head) const noexcept;
+    void skip_to(std::uint64_t sequence) noexcept;
+};
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "quote_feed.hpp"
+#include "metrics.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <string_view>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <shm-name> [count] [--from-oldest]\n";
+        return 1;
+    }
+    
+    std::uint64_t count = 0;
+    bool from_oldest = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--from-oldest") {
+            from_oldest = true;
+        } else {
+            count = std::stoull(argv[i]);
+        }
+    }
+    
+    try {
+        QuoteReader reader(argv[1], from_oldest);
+        QuoteRecord records[256];
+        std::uint64_t seen = 0;
+        std::uint64_t lost = 0;
+        
+        while (count == 0 || seen < count) {
+            std::size_t n = reader.poll(records, std::size(records));
+            if (reader.lost() != lost) {
+                std::cout << "(overrun: skipped " << reader.lost() - lost << " quotes)\n";
+                lost = reader.lost();
+            }
+            if (n == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            
+            std::int64_t now = monotonic_time_ns();
+            for (std::size_t i = 0; i < n && (count == 0 || seen < count); ++i, ++seen) {
+                const QuoteRecord& q = records[i];
+                std::cout << "#" << q.sequence << " option " << q.option_id
+                            << std::fixed << std::setprecision(4)
+                            << " bid " << q.bid << " ask " << q.ask
+                            << " [age " << (now - q.timestamp_ns) / 1000 << "us]\n";
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
\ No newline at end of file
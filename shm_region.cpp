@@ -0,0 +1,98 @@
+#include "shm_region.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error shm_error(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " shared memory '" + name + "': " + std::strerror(errno));
+}
+
+}
+
+SharedMemoryRegion SharedMemoryRegion::create(const std::string& name, std::size_t size) {
+    // A stale region left by a crashed writer is replaced, never reused, so
+    // readers still attached to it can't see a half-initialised layout.
+    if (::shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+        throw shm_error("Cannot replace", name);
+    }
+    
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw shm_error("Cannot create", name);
+    }
+    
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        throw shm_error("Cannot size", name);
+    }
+    
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw shm_error("Cannot map", name);
+    }
+    
+    return SharedMemoryRegion(name, data, size, true);
+}
+
+SharedMemoryRegion SharedMemoryRegion::open(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw shm_error("Cannot open", name);
+    }
+    
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory '" + name + "' is empty");
+    }
+    
+    auto size = static_cast<std::size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw shm_error("Cannot map", name);
+    }
+    
+    return SharedMemoryRegion(name, data, size, false);
+}
+
+SharedMemoryRegion::SharedMemoryRegion(std::string name, void* data, std::size_t size, bool owner)
+    : name_(std::move(name)), data_(data), size_(size), owner_(owner) {}
+
+SharedMemoryRegion::SharedMemoryRegion(SharedMemoryRegion&& other) noexcept
+    : name_(std::move(other.name_)), data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)), owner_(std::exchange(other.owner_, false)) {}
+
+SharedMemoryRegion& SharedMemoryRegion::operator=(SharedMemoryRegion&& other) noexcept {
+    if (this != &other) {
+        release();
+        name_ = std::move(other.name_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        owner_ = std::exchange(other.owner_, false);
+    }
+    return *this;
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    release();
+}
+
+void SharedMemoryRegion::release() noexcept {
+    if (data_) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+    }
+    if (owner_) {
+        ::shm_unlink(name_.c_str());
+        owner_ = false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class SharedMemoryRegion {
+public:
+    static SharedMemoryRegion create(const std::string& name, std::size_t size);
+    static SharedMemoryRegion open(const std::string& name);
+    
+    SharedMemoryRegion(SharedMemoryRegion&& other) noexcept;
+    SharedMemoryRegion& operator=(SharedMemoryRegion&& other) noexcept;
+    ~SharedMemoryRegion();
+    
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+    
+    void* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    SharedMemoryRegion(std::string name, void* data, std::size_t size, bool owner);
+    void release() noexcept;
+    
+    std::string name_;
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool owner_ = false;
+};
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "snapshot.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+std::runtime_error io_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+
+}
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw io_error("Cannot open", path);
+    }
+    
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw io_error("Cannot stat", path);
+    }
+    
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw io_error("Cannot map", path);
+        }
+        data_ = static_cast<const std::byte*>(mapped);
+    }
+    
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+void write_file_atomically(const std::string& path, const std::byte* data, std::size_t size) {
+    std::string tmp_path = path + ".tmp";
+    
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw io_error("Cannot create", tmp_path);
+    }
+    
+    std::size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            throw io_error("Cannot write", tmp_path);
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    
+    bool synced = ::fsync(fd) == 0;
+    if (::close(fd) != 0 || !synced) {
+        throw io_error("Cannot flush", tmp_path);
+    }
+    
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        throw io_error("Cannot rename", tmp_path);
+    }
+}
\ No newline at end of file
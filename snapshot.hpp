@@ -0,0 +1,78 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+constexpr std::uint32_t SNAPSHOT_MAGIC = 0x4E534D4D;
+constexpr std::uint32_t SNAPSHOT_VERSION = 5;
+constexpr std::size_t SNAPSHOT_ENGINE_NAME_SIZE = 32;
+
+struct SnapshotHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t total_size;
+    double pnl;
+    std::uint32_t safe_mode;
+    std::uint32_t reserved;
+    std::uint64_t option_position_count;
+    std::uint64_t underlying_position_count;
+    std::uint64_t hedge_count;
+    std::uint64_t target_delta_count;
+    std::uint64_t last_price_count;
+    std::uint64_t last_hedge_count;
+    std::uint64_t greeks_count;
+    std::uint64_t expiry_count;
+    char greeks_engine[SNAPSHOT_ENGINE_NAME_SIZE];
+};
+
+struct OptionPositionRecord {
+    OptionId option_id;
+    std::int32_t quantity;
+};
+
+struct UnderlyingLotsRecord {
+    UnderlyingId underlying_id;
+    std::int32_t reserved;
+    Lots lots;
+};
+
+struct UnderlyingAmountRecord {
+    UnderlyingId underlying_id;
+    std::int32_t reserved;
+    double amount;
+};
+
+struct ExpiryRecord {
+    OptionId option_id;
+    std::int32_t reserved;
+    Ticks underlying_ticks;
+};
+
+struct GreeksRecord {
+    OptionId option_id;
+    Steps steps_until_expiry;
+    Ticks spot_ticks;
+    double price;
+    double delta;
+    double gamma;
+};
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+void write_file_atomically(const std::string& path, const std::byte* data, std::size_t size);
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "base_market_maker.hpp"
+#include "lattice_pricer.hpp"
+#include "market_maker_core.hpp"
+#include <utility>
+
+struct NullExecutionSink {
+    bool submit(UnderlyingId, Quantity, Price) const noexcept { return true; }
+    Price pending_hedge(UnderlyingId) const noexcept { return 0.0; }
+};
+
+struct CallbackExecutionSink {
+    TradeCallback callback;
+    
+    bool submit(UnderlyingId underlying_id, Quantity quantity, Price) const {
+        if (callback) {
+            callback(underlying_id, quantity);
+        }
+        return true;
+    }
+    
+    Price pending_hedge(UnderlyingId) const noexcept { return 0.0; }
+};
+
+// Reports hedges to whatever callback is registered on the owning market
+// maker at the time, like MarketMaker does without a venue attached.
+struct RegisteredCallbackSink {
+    const BaseMarketMaker* owner = nullptr;
+    
+    bool submit(UnderlyingId underlying_id, Quantity quantity, Price) const {
+        if (owner->trade_underlying_callback) {
+            owner->trade_underlying_callback(underlying_id, quantity);
+        }
+        return true;
+    }
+    
+    Price pending_hedge(UnderlyingId) const noexcept { return 0.0; }
+};
+
+// MarketMaker's strategy core with the pricer, hedger and execution sink fixed
+// at compile time and no virtual interface. Surfaces, per-contract engines,
+// async hedging, snapshots and the shared-memory publishers are MarketMaker-only.
+template <typename Pricer = LatticePricer,
+          typename Hedger = DeltaHedger,
+          typename ExecutionSink = NullExecutionSink>
+class StaticMarketMaker : public MarketState {
+public:
+    using Core = MarketMakerCore<Pricer, Hedger, ExecutionSink>;
+    
+    StaticMarketMaker(UnderlyingVector underlying_initial_state,
+                      OptionVector option_initial_state,
+                      StrategyParams strategy_params = {},
+                      GreeksCacheConfig cache_config = {},
+                      Pricer pricer = Pricer{},
+                      Hedger hedger = Hedger{},
+                      ExecutionSink sink = ExecutionSink{})
+        :   MarketState{std::move(underlying_initial_state), std::move(option_initial_state), Position{}},
+            core(*this, strategy_params, cache_config, std::move(pricer), std::move(hedger), std::move(sink)) {}
+    
+    StaticMarketMaker(const StaticMarketMaker&) = delete;
+    StaticMarketMaker& operator=(const StaticMarketMaker&) = delete;
+    
+    BidAsk make_market(const Option& option) { return core.quote(option); }
+    Price price_option(const Option& option) { return core.price_option(option); }
+    
+    void on_bid_hit(const Option& option, Price bid_price) { core.on_bid_hit(option, bid_price); }
+    void on_offer_hit(const Option& option, Price offer_price) { core.on_offer_hit(option, offer_price); }
+    
+    void on_step_advance(UnderlyingVector new_underlying_state,
+                         OptionVector new_option_state) {
+        underlying_state = std::move(new_underlying_state);
+        active_option_state = std::move(new_option_state);
+        core.sync_state();
+        core.advance(1);
+    }
+    
+    Price mark_to_market() { return core.mark_to_market(); }
+    
+    Pricer& pricer() noexcept { return core.pricer(); }
+    Hedger& hedger() noexcept { return core.hedger(); }
+    ExecutionSink& execution_sink() noexcept { return core.execution_sink(); }
+    
+    const GreeksCacheStats& cache_stats() const noexcept { return core.cache().stats(); }
+    const StrategyParams& strategy_params() const noexcept { return core.strategy_params(); }
+    Price realized_pnl() const noexcept { return core.state().pnl; }
+    bool in_safe_mode() const noexcept { return core.state().safe_mode; }
+
+private:
+    Core core;
+};
+
+// Puts a statically configured core behind the BaseMarketMaker interface. The
+// core trades against the base class's book, so there is one position.
+template <typename Pricer = LatticePricer, typename Hedger = DeltaHedger>
+class VirtualMarketMakerAdapter : public BaseMarketMaker {
+public:
+    using Core = MarketMakerCore<Pricer, Hedger, RegisteredCallbackSink>;
+    
+    VirtualMarketMakerAdapter(UnderlyingVector underlying_initial_state,
+                              OptionVector option_initial_state,
+                              StrategyParams strategy_params = {},
+                              GreeksCacheConfig cache_config = {},
+                              Pricer pricer = Pricer{},
+                              Hedger hedger = Hedger{})
+        :   BaseMarketMaker(std::move(underlying_initial_state), std::move(option_initial_state)),
+            core(*this, strategy_params, cache_config, std::move(pricer), std::move(hedger),
+                 RegisteredCallbackSink{this}) {}
+    
+    VirtualMarketMakerAdapter(VirtualMarketMakerAdapter&&) = delete;
+    VirtualMarketMakerAdapter& operator=(VirtualMarketMakerAdapter&&) = delete;
+    
+    BidAsk make_market(const Option& option) override { return core.quote(option); }
+    Price price_option(const Option& option) override { return core.price_option(option); }
+    
+    void on_bid_hit(const Option& option, Price bid_price) override { core.on_bid_hit(option, bid_price); }
+    void on_offer_hit(const Option& option, Price offer_price) override { core.on_offer_hit(option, offer_price); }
+    
+    void on_step_advance(UnderlyingVector new_underlying_state,
+                         OptionVector new_option_state) override {
+        BaseMarketMaker::on_step_advance(std::move(new_underlying_state), std::move(new_option_state));
+        core.sync_state();
+        core.advance(1);
+    }
+    
+    Price mark_to_market() { return core.mark_to_market(); }
+    Core& strategy_core() noexcept { return core; }
+
+private:
+    Core core;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "types.hpp"
+#include <algorithm>
+#include <cmath>
+
+struct StrategyParams {
+    Price min_hedge = 0.05;
+    Price hedge_threshold = 0.03;
+    Price gamma_scalp_threshold = 0.005;
+    Price max_loss = -50000.0;
+    double recovery_fraction = 0.5;
+    
+    double base_spread = 0.02;
+    Price min_spread = 0.01;
+    double gamma_spread_scale = 0.1;
+    double gamma_spread_cap = 0.5;
+    
+    Steps near_expiry_steps = 2;
+    double near_expiry_multiplier = 2.0;
+    Steps mid_expiry_steps = 5;
+    double mid_expiry_multiplier = 1.3;
+};
+
+// The quote and hedge rules are shared by MarketMaker and StaticMarketMaker,
+// so both make the same decisions from the same prices and Greeks.
+inline BidAsk quote_around(const StrategyParams& params, Price fair, Price gamma, Price spot,
+                           Steps steps_until_expiry, int position) noexcept {
+    Price base_spread = std::max(params.min_spread, fair * params.base_spread);
+    Price gamma_adj = std::min(params.gamma_spread_cap, std::abs(gamma) * spot * params.gamma_spread_scale);
+    
+    Price time_adj = 1.0;
+    if (steps_until_expiry <= params.near_expiry_steps) {
+        time_adj = params.near_expiry_multiplier;
+    } else if (steps_until_expiry <= params.mid_expiry_steps) {
+        time_adj = params.mid_expiry_multiplier;
+    }
+    
+    Price spread = base_spread * time_adj * (1 + gamma_adj);
+    
+    Price bid = std::max(0.0, fair - spread / 2);
+    Price ask = fair + spread / 2;
+    
+    if (position > MAX_POSITIONS) {
+        bid = 0.01;
+    } else if (position < -MAX_POSITIONS) {
+        ask = ask * 10;
+    }
+    
+    return std::make_tuple(bid, ask);
+}
+
+struct DeltaHedger {
+    // Change in hedge after a fill, or zero when the net delta is inside the
+    // threshold or the trade would be smaller than min_hedge.
+    Price fill_hedge(const StrategyParams& params, Price net_delta, Price hedge_position) const noexcept {
+        if (std::abs(net_delta) <= params.hedge_threshold) {
+            return 0.0;
+        }
+        Price hedge_trade = net_delta - hedge_position;
+        return (std::abs(hedge_trade) < params.min_hedge) ? 0.0 : hedge_trade;
+    }
+    
+    bool rehedge_due(const StrategyParams& params, Price price_move) const noexcept {
+        return !(std::abs(price_move) < params.gamma_scalp_threshold);
+    }
+    
+    Price step_hedge(const StrategyParams& params, Price net_delta) const noexcept {
+        return (std::abs(net_delta) > params.hedge_threshold) ? net_delta : 0.0;
+    }
+};
\ No newline at end of file
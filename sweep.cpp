@@ -0,0 +1,240 @@
+#include "sweep.hpp"
+#include "market_maker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// P&L is tracked as cash from premiums and hedge trades, plus the holdings
+// marked at fair value. MarketMaker's own pnl field is not cash.
+struct PathOutcome {
+    Price cash = 0.0;
+    std::unordered_map<UnderlyingId, Quantity> underlying_position;
+    Price pnl = 0.0;
+    Price hedge_cost = 0.0;
+    Price max_drawdown = 0.0;
+    std::uint64_t fills = 0;
+    std::uint64_t hedge_trades = 0;
+};
+
+UnderlyingVector underlyings_at(const PathSet& paths, int path, int step) {
+    const auto& initial = paths.initial_underlyings();
+    UnderlyingVector state;
+    state.reserve(initial.size());
+    
+    for (size_t i = 0; i < initial.size(); ++i) {
+        const Underlying& u = *initial[i];
+        state.emplace_back(std::make_shared<Underlying>(
+            u.name, u.underlying_id, from_ticks(paths.valuation_ticks(path, step, i)),
+            u.down_move_probability, u.down_move_step, u.noise_std_dev,
+            u.up_move_probability, u.up_move_step));
+    }
+    
+    return state;
+}
+
+Price cash_pnl(MarketMaker& mm, const PathOutcome& outcome) {
+    Price total = outcome.cash;
+    
+    for (const auto& opt_ptr : mm.active_option_state) {
+        int quantity = mm.position.option_quantity(opt_ptr->option_id);
+        if (quantity != 0) {
+            total += quantity * mm.price_option(*opt_ptr);
+        }
+    }
+    
+    for (const auto& u_ptr : mm.underlying_state) {
+        auto it = outcome.underlying_position.find(u_ptr->underlying_id);
+        if (it != outcome.underlying_position.end()) {
+            total += it->second * u_ptr->valuation;
+        }
+    }
+    
+    return total;
+}
+
+PathOutcome simulate_path(const PathSet& paths, int path, const StrategyParams& params,
+                          const SweepConfig& config) {
+    GreeksCacheConfig cache_config;
+    cache_config.memory_budget_bytes = 1u << 20;
+    
+    MarketMaker mm{underlyings_at(paths, path, 0), OptionVector(paths.initial_options()),
+                   params, cache_config};
+    
+    PathOutcome outcome;
+    mm.register_trade_underlying_callback([&mm, &outcome](UnderlyingId id, Quantity qty) {
+        // Position books whole lots, so cash is paid on the rounded quantity.
+        Quantity held = from_lots(to_lots(qty));
+        for (const auto& u_ptr : mm.underlying_state) {
+            if (u_ptr->underlying_id == id) {
+                outcome.hedge_cost += std::abs(held) * u_ptr->valuation;
+                outcome.cash -= held * u_ptr->valuation;
+                break;
+            }
+        }
+        outcome.underlying_position[id] += held;
+        ++outcome.hedge_trades;
+    });
+    
+    std::mt19937_64 flow(paths.seed() ^ (0x9e3779b97f4a7c15ULL * (path + 1)));
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+    Price peak = std::numeric_limits<Price>::lowest();
+    
+    for (int step = 0; step < paths.step_count(); ++step) {
+        for (const auto& opt_ptr : mm.active_option_state) {
+            const Option& option = *opt_ptr;
+            auto [bid, ask] = mm.make_market(option);
+            
+            // Safe-mode quotes are meant to be unfillable, so clients pass on them.
+            double draw = uniform(flow);
+            if (mm.in_safe_mode()) {
+                continue;
+            }
+            if (draw < config.hit_probability) {
+                mm.on_bid_hit(option, bid);
+                outcome.cash -= bid;
+                ++outcome.fills;
+            } else if (draw < 2 * config.hit_probability) {
+                mm.on_offer_hit(option, ask);
+                outcome.cash += ask;
+                ++outcome.fills;
+            }
+        }
+        
+        Price value = cash_pnl(mm, outcome);
+        peak = std::max(peak, value);
+        outcome.max_drawdown = std::max(outcome.max_drawdown, peak - value);
+        
+        if (step + 1 < paths.step_count()) {
+            OptionVector next_options;
+            next_options.reserve(mm.active_option_state.size());
+            for (const auto& opt_ptr : mm.active_option_state) {
+                next_options.emplace_back(opt_ptr->advance_step());
+            }
+            mm.on_step_advance(underlyings_at(paths, path, step + 1), std::move(next_options));
+        }
+    }
+    
+    outcome.pnl = cash_pnl(mm, outcome);
+    return outcome;
+}
+
+SweepResult evaluate(const PathSet& paths, const StrategyParams& params, const SweepConfig& config) {
+    SweepResult result{params, 0.0, std::numeric_limits<Price>::max(), 0.0, 0.0, 0, 0};
+    
+    for (int path = 0; path < paths.path_count(); ++path) {
+        PathOutcome outcome = simulate_path(paths, path, params, config);
+        result.mean_pnl += outcome.pnl;
+        result.worst_pnl = std::min(result.worst_pnl, outcome.pnl);
+        result.mean_hedge_cost += outcome.hedge_cost;
+        result.max_drawdown = std::max(result.max_drawdown, outcome.max_drawdown);
+        result.fills += outcome.fills;
+        result.hedge_trades += outcome.hedge_trades;
+    }
+    
+    if (paths.path_count() > 0) {
+        result.mean_pnl /= paths.path_count();
+        result.mean_hedge_cost /= paths.path_count();
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> or_default(const std::vector<T>& values, T fallback) {
+    return values.empty() ? std::vector<T>{fallback} : values;
+}
+
+}
+
+PathSet PathSet::generate(const UnderlyingVector& initial_underlyings, OptionVector initial_options,
+                          int path_count, int step_count, std::uint64_t seed) {
+    if (path_count <= 0 || step_count <= 0) {
+        throw std::invalid_argument("Path and step counts must be positive");
+    }
+    
+    PathSet paths;
+    paths.initial_underlyings_ = initial_underlyings;
+    paths.initial_options_ = std::move(initial_options);
+    paths.path_count_ = path_count;
+    paths.step_count_ = step_count;
+    paths.seed_ = seed;
+    
+    size_t width = initial_underlyings.size();
+    paths.ticks_.resize(static_cast<size_t>(path_count) * step_count * width);
+    
+    for (int path = 0; path < path_count; ++path) {
+        std::mt19937 gen(static_cast<std::mt19937::result_type>(seed + path));
+        UnderlyingVector state = initial_underlyings;
+        
+        for (int step = 0; step < step_count; ++step) {
+            for (size_t i = 0; i < width; ++i) {
+                Ticks ticks = state[i]->valuation_ticks;
+                if (ticks > std::numeric_limits<std::int32_t>::max()) {
+                    throw std::overflow_error("Underlying valuation does not fit the compact path format");
+                }
+                paths.ticks_[(static_cast<size_t>(path) * step_count + step) * width + i] = static_cast<std::int32_t>(ticks);
+                state[i] = state[i]->advance_step(gen);
+            }
+        }
+    }
+    
+    return paths;
+}
+
+std::vector<StrategyParams> ParameterGrid::expand() const {
+    std::vector<StrategyParams> combinations{base};
+    
+    auto cross = [&combinations](const auto& values, auto setter) {
+        std::vector<StrategyParams> next;
+        next.reserve(combinations.size() * values.size());
+        for (const auto& params : combinations) {
+            for (const auto& value : values) {
+                StrategyParams p = params;
+                setter(p, value);
+                next.push_back(p);
+            }
+        }
+        combinations.swap(next);
+    };
+    
+    cross(or_default(min_hedge, base.min_hedge), [](StrategyParams& p, Price v) { p.min_hedge = v; });
+    cross(or_default(hedge_threshold, base.hedge_threshold), [](StrategyParams& p, Price v) { p.hedge_threshold = v; });
+    cross(or_default(gamma_scalp_threshold, base.gamma_scalp_threshold), [](StrategyParams& p, Price v) { p.gamma_scalp_threshold = v; });
+    cross(or_default(max_loss, base.max_loss), [](StrategyParams& p, Price v) { p.max_loss = v; });
+    cross(or_default(base_spread, base.base_spread), [](StrategyParams& p, double v) { p.base_spread = v; });
+    cross(or_default(near_expiry_multiplier, base.near_expiry_multiplier), [](StrategyParams& p, double v) { p.near_expiry_multiplier = v; });
+    cross(or_default(mid_expiry_multiplier, base.mid_expiry_multiplier), [](StrategyParams& p, double v) { p.mid_expiry_multiplier = v; });
+    
+    return combinations;
+}
+
+std::vector<SweepResult> run_sweep(const PathSet& paths, const std::vector<StrategyParams>& combinations,
+                                   SweepConfig config) {
+    std::vector<SweepResult> results(combinations.size());
+    std::atomic<size_t> next{0};
+    
+    unsigned threads = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, combinations.size())));
+    
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < combinations.size(); i = next.fetch_add(1)) {
+            results[i] = evaluate(paths, combinations[i], config);
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    
+    return results;
+}
\ No newline at end of file
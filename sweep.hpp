@@ -0,0 +1,63 @@
+#pragma once
+
+#include "types.hpp"
+#include "strategy_params.hpp"
+#include <cstdint>
+
+class PathSet {
+public:
+    static PathSet generate(const UnderlyingVector& initial_underlyings, OptionVector initial_options,
+                            int path_count, int step_count, std::uint64_t seed);
+    
+    const UnderlyingVector& initial_underlyings() const noexcept { return initial_underlyings_; }
+    const OptionVector& initial_options() const noexcept { return initial_options_; }
+    int path_count() const noexcept { return path_count_; }
+    int step_count() const noexcept { return step_count_; }
+    std::uint64_t seed() const noexcept { return seed_; }
+    
+    Ticks valuation_ticks(int path, int step, size_t underlying_index) const noexcept {
+        size_t width = initial_underlyings_.size();
+        return ticks_[(static_cast<size_t>(path) * step_count_ + step) * width + underlying_index];
+    }
+    
+    std::size_t memory_bytes() const noexcept { return ticks_.size() * sizeof(std::int32_t); }
+
+private:
+    UnderlyingVector initial_underlyings_;
+    OptionVector initial_options_;
+    int path_count_ = 0;
+    int step_count_ = 0;
+    std::uint64_t seed_ = 0;
+    std::vector<std::int32_t> ticks_;
+};
+
+struct ParameterGrid {
+    StrategyParams base;
+    std::vector<Price> min_hedge;
+    std::vector<Price> hedge_threshold;
+    std::vector<Price> gamma_scalp_threshold;
+    std::vector<Price> max_loss;
+    std::vector<double> base_spread;
+    std::vector<double> near_expiry_multiplier;
+    std::vector<double> mid_expiry_multiplier;
+    
+    std::vector<StrategyParams> expand() const;
+};
+
+struct SweepResult {
+    StrategyParams params;
+    Price mean_pnl;
+    Price worst_pnl;
+    Price mean_hedge_cost;
+    Price max_drawdown;
+    std::uint64_t fills;
+    std::uint64_t hedge_trades;
+};
+
+struct SweepConfig {
+    unsigned threads = 0;
+    double hit_probability = 0.2;
+};
+
+std::vector<SweepResult> run_sweep(const PathSet& paths, const std::vector<StrategyParams>& combinations,
+                                   SweepConfig config = {});
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <functional>
 #include <tuple>
 #include <string_view>
+#include <cstdint>
 
 struct Underlying;
 struct Option;
@@ -17,12 +18,32 @@ using Quantity = double;
 using Steps = int;
 using Strike = int;
 using Probability = double;
+using Ticks = std::int64_t;
+using Lots = std::int64_t;
+
+constexpr Ticks TICKS_PER_UNIT = 100;
+constexpr Lots LOTS_PER_UNIT = 100;
+
+constexpr Ticks to_ticks(Price price) noexcept {
+    double scaled = price * TICKS_PER_UNIT;
+    return static_cast<Ticks>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+constexpr Price from_ticks(Ticks ticks) noexcept {
+    return static_cast<Price>(ticks) / TICKS_PER_UNIT;
+}
+
+constexpr Lots to_lots(Quantity quantity) noexcept {
+    double scaled = quantity * LOTS_PER_UNIT;
+    return static_cast<Lots>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+constexpr Quantity from_lots(Lots lots) noexcept {
+    return static_cast<Quantity>(lots) / LOTS_PER_UNIT;
+}
 
 using Greeks = std::tuple<Price, Price, Price>;
 using BidAsk = std::tuple<Price, Price>;
-using OptionQuantityMap = std::unordered_map<OptionId, int>;
-using UnderlyingQuantityMap = std::unordered_map<UnderlyingId, Quantity>;
-using PriceCache = std::unordered_map<std::string, Greeks>;
 using DeltaMap = std::unordered_map<UnderlyingId, Price>;
 using TradeCallback = std::function<void(UnderlyingId, Quantity)>;
 
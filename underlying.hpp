@@ -2,11 +2,33 @@
 
 #include "types.hpp"
 #include <string>
+#include <string_view>
+#include <random>
+
+struct PrevalidatedTag {};
+inline constexpr PrevalidatedTag PREVALIDATED{};
+
+// Underlying name interned for the life of the process. Options hold one of
+// these, so copying an option copies a view rather than the name.
+class UnderlyingName {
+public:
+    UnderlyingName() = default;
+    explicit UnderlyingName(std::string_view name);
+    
+    std::string_view view() const noexcept { return name_; }
+    
+    bool operator==(const UnderlyingName& other) const noexcept { return name_ == other.name_; }
+    bool operator!=(const UnderlyingName& other) const noexcept { return name_ != other.name_; }
+
+private:
+    std::string_view name_;
+};
 
 struct Underlying {
     std::string name;
     UnderlyingId underlying_id;
     Price valuation;
+    Ticks valuation_ticks;
     Probability down_move_probability;
     Price down_move_step;
     Price noise_std_dev;
@@ -17,6 +39,10 @@ struct Underlying {
                 Probability down_prob, Price down_step, Price noise,
                 Probability up_prob, Price up_step);
     
+    Underlying(PrevalidatedTag, std::string name, UnderlyingId id, Price val,
+                Probability down_prob, Price down_step, Price noise,
+                Probability up_prob, Price up_step) noexcept;
+    
     Underlying(const Underlying&) = default;
     Underlying(Underlying&&) noexcept = default;
     
@@ -28,6 +54,10 @@ struct Underlying {
     bool operator==(const Underlying& other) const noexcept;
     
     UnderlyingPtr advance_step() const;
+    UnderlyingPtr advance_step(std::mt19937& gen) const;
+    
+    static const char* parameter_error(Probability down_prob, Price down_step,
+                                       Probability up_prob, Price up_step) noexcept;
 
 private:
     void validate_parameters() const;
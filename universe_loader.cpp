@@ -0,0 +1,436 @@
+#include "universe_loader.hpp"
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+static_assert(sizeof(UnderlyingId) == 4 && sizeof(OptionId) == 4);
+static_assert(sizeof(Steps) == 4 && sizeof(Strike) == 4);
+
+namespace {
+
+constexpr std::size_t VALIDATION_BLOCK = 8;
+
+struct UniverseLayout {
+    std::size_t valuation;
+    std::size_t down_move_probability;
+    std::size_t down_move_step;
+    std::size_t noise_std_dev;
+    std::size_t up_move_probability;
+    std::size_t up_move_step;
+    std::size_t underlying_id;
+    std::size_t name_offset;
+    std::size_t name_length;
+    std::size_t option_id;
+    std::size_t option_underlying_id;
+    std::size_t steps_until_expiry;
+    std::size_t strike;
+    std::size_t option_type;
+    std::size_t strings;
+    std::size_t total;
+    
+    static UniverseLayout compute(std::size_t underlyings, std::size_t options, std::size_t strings) {
+        UniverseLayout layout{};
+        std::size_t offset = sizeof(UniverseHeader);
+        auto column = [&offset](std::size_t count, std::size_t width) {
+            std::size_t start = offset;
+            offset = (offset + count * width + 7) & ~std::size_t{7};
+            return start;
+        };
+        
+        layout.valuation = column(underlyings, sizeof(double));
+        layout.down_move_probability = column(underlyings, sizeof(double));
+        layout.down_move_step = column(underlyings, sizeof(double));
+        layout.noise_std_dev = column(underlyings, sizeof(double));
+        layout.up_move_probability = column(underlyings, sizeof(double));
+        layout.up_move_step = column(underlyings, sizeof(double));
+        layout.underlying_id = column(underlyings, sizeof(UnderlyingId));
+        layout.name_offset = column(underlyings, sizeof(std::uint32_t));
+        layout.name_length = column(underlyings, sizeof(std::uint32_t));
+        layout.option_id = column(options, sizeof(OptionId));
+        layout.option_underlying_id = column(options, sizeof(UnderlyingId));
+        layout.steps_until_expiry = column(options, sizeof(Steps));
+        layout.strike = column(options, sizeof(Strike));
+        layout.option_type = column(options, sizeof(std::uint8_t));
+        layout.strings = column(strings, 1);
+        layout.total = offset;
+        return layout;
+    }
+};
+
+struct CsvColumns {
+    std::vector<double> valuation;
+    std::vector<double> down_move_probability;
+    std::vector<double> down_move_step;
+    std::vector<double> noise_std_dev;
+    std::vector<double> up_move_probability;
+    std::vector<double> up_move_step;
+    std::vector<UnderlyingId> underlying_id;
+    std::vector<std::uint32_t> name_offset;
+    std::vector<std::uint32_t> name_length;
+    std::vector<OptionId> option_id;
+    std::vector<UnderlyingId> option_underlying_id;
+    std::vector<Steps> steps_until_expiry;
+    std::vector<Strike> strike;
+    std::vector<std::uint8_t> option_type;
+    std::string strings;
+};
+
+class CsvLine {
+public:
+    CsvLine(std::string_view line, std::size_t line_number) : rest(line), number(line_number) {}
+    
+    std::string_view field() {
+        std::size_t comma = rest.find(',');
+        std::string_view value = rest.substr(0, comma);
+        rest = (comma == std::string_view::npos) ? std::string_view{} : rest.substr(comma + 1);
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\r')) value.remove_suffix(1);
+        while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+        if (value.empty()) {
+            fail("missing field");
+        }
+        return value;
+    }
+    
+    template <typename T>
+    T number_field() {
+        std::string_view text = field();
+        T value{};
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc() || end != text.data() + text.size()) {
+            fail("invalid number '" + std::string(text) + "'");
+        }
+        return value;
+    }
+    
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::invalid_argument("Universe CSV line " + std::to_string(number) + ": " + what);
+    }
+
+private:
+    std::string_view rest;
+    std::size_t number;
+};
+
+template <typename T>
+void copy_column(std::vector<std::byte>& image, std::size_t offset, const std::vector<T>& column) {
+    if (!column.empty()) {
+        std::memcpy(image.data() + offset, column.data(), column.size() * sizeof(T));
+    }
+}
+
+template <typename T>
+const T* column_at(const std::byte* data, std::size_t offset) {
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+std::size_t first_invalid_underlying(const UniverseView& v, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!(v.valuation[i] >= 0)
+            || Underlying::parameter_error(v.down_move_probability[i], v.down_move_step[i],
+                                           v.up_move_probability[i], v.up_move_step[i])
+            || std::uint64_t{v.name_offset[i]} + v.name_length[i] > v.string_table_size) {
+            return i;
+        }
+    }
+    return end;
+}
+
+std::size_t first_invalid_option(const UniverseView& v, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (v.steps_until_expiry[i] < 0 || v.option_type[i] > 1) {
+            return i;
+        }
+    }
+    return end;
+}
+
+[[noreturn]] void reject_underlying(const UniverseView& v, std::size_t i) {
+    std::string id = "Underlying " + std::to_string(v.underlying_id[i]) + ": ";
+    if (std::uint64_t{v.name_offset[i]} + v.name_length[i] > v.string_table_size) {
+        throw std::invalid_argument(id + "name lies outside the string table");
+    }
+    if (!(v.valuation[i] >= 0)) {
+        throw std::invalid_argument(id + "valuation must be non-negative");
+    }
+    throw std::invalid_argument(id + Underlying::parameter_error(v.down_move_probability[i], v.down_move_step[i],
+                                                                 v.up_move_probability[i], v.up_move_step[i]));
+}
+
+[[noreturn]] void reject_option(const UniverseView& v, std::size_t i) {
+    std::string id = "Option " + std::to_string(v.option_id[i]) + ": ";
+    if (v.option_type[i] > 1) {
+        throw std::invalid_argument(id + "unknown option type");
+    }
+    throw std::invalid_argument(id + "Steps until expiry must be non-negative");
+}
+
+// Compiled universes normally list options in id order, which is checked in a
+// single pass. Anything else is sorted into a copy to find repeated ids.
+void reject_duplicate_options(const UniverseView& v) {
+    const OptionId* ids = v.option_id;
+    std::size_t n = v.option_count;
+    if (std::adjacent_find(ids, ids + n, std::greater_equal<OptionId>()) == ids + n) {
+        return;
+    }
+    
+    std::vector<OptionId> sorted(ids, ids + n);
+    std::sort(sorted.begin(), sorted.end());
+    auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+    if (duplicate != sorted.end()) {
+        throw std::invalid_argument("Duplicate option id " + std::to_string(*duplicate));
+    }
+}
+
+}
+
+UniverseImage UniverseImage::open(const std::string& path) {
+    auto file = std::make_unique<MappedFile>(path);
+    
+    std::uint32_t magic = 0;
+    if (file->size() >= sizeof(magic)) {
+        std::memcpy(&magic, file->data(), sizeof(magic));
+    }
+    
+    if (magic != UNIVERSE_MAGIC) {
+        std::string_view text(reinterpret_cast<const char*>(file->data()), file->size());
+        return parse_csv(text);
+    }
+    
+    UniverseImage image;
+    image.attach(file->data(), file->size());
+    image.mapped_ = std::move(file);
+    return image;
+}
+
+UniverseImage UniverseImage::parse_csv(std::string_view text) {
+    CsvColumns c;
+    std::size_t line_number = 0;
+    
+    while (!text.empty()) {
+        std::size_t newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = (newline == std::string_view::npos) ? std::string_view{} : text.substr(newline + 1);
+        ++line_number;
+        
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.remove_suffix(1);
+        if (line.empty() || line.front() == '#') continue;
+        
+        CsvLine fields(line, line_number);
+        std::string_view kind = fields.field();
+        
+        if (kind == "U") {
+            c.underlying_id.push_back(fields.number_field<UnderlyingId>());
+            std::string_view name = fields.field();
+            c.name_offset.push_back(static_cast<std::uint32_t>(c.strings.size()));
+            c.name_length.push_back(static_cast<std::uint32_t>(name.size()));
+            c.strings.append(name);
+            c.valuation.push_back(fields.number_field<double>());
+            c.down_move_probability.push_back(fields.number_field<double>());
+            c.down_move_step.push_back(fields.number_field<double>());
+            c.noise_std_dev.push_back(fields.number_field<double>());
+            c.up_move_probability.push_back(fields.number_field<double>());
+            c.up_move_step.push_back(fields.number_field<double>());
+        } else if (kind == "O") {
+            c.option_id.push_back(fields.number_field<OptionId>());
+            c.option_underlying_id.push_back(fields.number_field<UnderlyingId>());
+            std::string_view type = fields.field();
+            if (type == to_string_view(OptionType::CALL)) {
+                c.option_type.push_back(static_cast<std::uint8_t>(OptionType::CALL));
+            } else if (type == to_string_view(OptionType::PUT)) {
+                c.option_type.push_back(static_cast<std::uint8_t>(OptionType::PUT));
+            } else {
+                fields.fail("unknown option type '" + std::string(type) + "'");
+            }
+            c.steps_until_expiry.push_back(fields.number_field<Steps>());
+            c.strike.push_back(fields.number_field<Strike>());
+        } else {
+            fields.fail("unknown record kind '" + std::string(kind) + "'");
+        }
+    }
+    
+    std::size_t underlyings = c.underlying_id.size();
+    std::size_t options = c.option_id.size();
+    UniverseLayout layout = UniverseLayout::compute(underlyings, options, c.strings.size());
+    
+    UniverseImage image;
+    image.owned_.resize(layout.total);
+    
+    UniverseHeader header{UNIVERSE_MAGIC, UNIVERSE_VERSION, layout.total, underlyings, options, c.strings.size()};
+    std::memcpy(image.owned_.data(), &header, sizeof(header));
+    
+    copy_column(image.owned_, layout.valuation, c.valuation);
+    copy_column(image.owned_, layout.down_move_probability, c.down_move_probability);
+    copy_column(image.owned_, layout.down_move_step, c.down_move_step);
+    copy_column(image.owned_, layout.noise_std_dev, c.noise_std_dev);
+    copy_column(image.owned_, layout.up_move_probability, c.up_move_probability);
+    copy_column(image.owned_, layout.up_move_step, c.up_move_step);
+    copy_column(image.owned_, layout.underlying_id, c.underlying_id);
+    copy_column(image.owned_, layout.name_offset, c.name_offset);
+    copy_column(image.owned_, layout.name_length, c.name_length);
+    copy_column(image.owned_, layout.option_id, c.option_id);
+    copy_column(image.owned_, layout.option_underlying_id, c.option_underlying_id);
+    copy_column(image.owned_, layout.steps_until_expiry, c.steps_until_expiry);
+    copy_column(image.owned_, layout.strike, c.strike);
+    copy_column(image.owned_, layout.option_type, c.option_type);
+    std::memcpy(image.owned_.data() + layout.strings, c.strings.data(), c.strings.size());
+    
+    image.attach(image.owned_.data(), image.owned_.size());
+    return image;
+}
+
+void UniverseImage::attach(const std::byte* data, std::size_t size) {
+    if (size < sizeof(UniverseHeader)) {
+        throw std::runtime_error("Universe file is truncated");
+    }
+    
+    UniverseHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != UNIVERSE_MAGIC) {
+        throw std::runtime_error("Not a universe file");
+    }
+    if (header.version != UNIVERSE_VERSION) {
+        throw std::runtime_error("Unsupported universe version " + std::to_string(header.version));
+    }
+    if (header.underlying_count > size || header.option_count > size || header.string_table_size > size) {
+        throw std::runtime_error("Universe file is truncated");
+    }
+    
+    UniverseLayout layout = UniverseLayout::compute(header.underlying_count, header.option_count,
+                                                    header.string_table_size);
+    if (header.total_size != size || layout.total != size) {
+        throw std::runtime_error("Universe size mismatch");
+    }
+    
+    data_ = data;
+    size_ = size;
+    
+    view_.underlying_count = header.underlying_count;
+    view_.option_count = header.option_count;
+    view_.string_table_size = header.string_table_size;
+    view_.valuation = column_at<double>(data, layout.valuation);
+    view_.down_move_probability = column_at<double>(data, layout.down_move_probability);
+    view_.down_move_step = column_at<double>(data, layout.down_move_step);
+    view_.noise_std_dev = column_at<double>(data, layout.noise_std_dev);
+    view_.up_move_probability = column_at<double>(data, layout.up_move_probability);
+    view_.up_move_step = column_at<double>(data, layout.up_move_step);
+    view_.underlying_id = column_at<UnderlyingId>(data, layout.underlying_id);
+    view_.name_offset = column_at<std::uint32_t>(data, layout.name_offset);
+    view_.name_length = column_at<std::uint32_t>(data, layout.name_length);
+    view_.option_id = column_at<OptionId>(data, layout.option_id);
+    view_.option_underlying_id = column_at<UnderlyingId>(data, layout.option_underlying_id);
+    view_.steps_until_expiry = column_at<Steps>(data, layout.steps_until_expiry);
+    view_.strike = column_at<Strike>(data, layout.strike);
+    view_.option_type = column_at<std::uint8_t>(data, layout.option_type);
+    view_.strings = reinterpret_cast<const char*>(data + layout.strings);
+}
+
+void UniverseImage::write(const std::string& path) const {
+    write_file_atomically(path, data_, size_);
+}
+
+void validate_universe(const UniverseView& v) {
+    // Fixed-width blocks of branch-free comparisons let the compiler vectorize
+    // the common all-valid case; the scalar checks only run to name a failure.
+    std::size_t n = v.underlying_count;
+    std::size_t i = 0;
+    for (; i + VALIDATION_BLOCK <= n; i += VALIDATION_BLOCK) {
+        const double* p_down = v.down_move_probability + i;
+        const double* p_up = v.up_move_probability + i;
+        const double* down = v.down_move_step + i;
+        const double* up = v.up_move_step + i;
+        const double* valuation = v.valuation + i;
+        
+        double bad = 0.0;
+        for (std::size_t k = 0; k < VALIDATION_BLOCK; ++k) {
+            double mass = p_down[k] + p_up[k] - 1.0;
+            double drift = p_down[k] * down[k] - p_up[k] * up[k];
+            bad += (down[k] <= 0 ? 1.0 : 0.0) + (up[k] <= 0 ? 1.0 : 0.0)
+                 + (p_down[k] <= 0 ? 1.0 : 0.0) + (p_up[k] <= 0 ? 1.0 : 0.0)
+                 + (std::fabs(mass) > 1e-9 ? 1.0 : 0.0) + (std::fabs(drift) > 1e-5 ? 1.0 : 0.0)
+                 + (valuation[k] >= 0 ? 0.0 : 1.0);
+        }
+        for (std::size_t k = i; k < i + VALIDATION_BLOCK; ++k) {
+            bad += (std::uint64_t{v.name_offset[k]} + v.name_length[k] > v.string_table_size) ? 1.0 : 0.0;
+        }
+        if (bad != 0.0) {
+            std::size_t first = first_invalid_underlying(v, i, i + VALIDATION_BLOCK);
+            if (first != i + VALIDATION_BLOCK) {
+                reject_underlying(v, first);
+            }
+        }
+    }
+    if (std::size_t first = first_invalid_underlying(v, i, n); first != n) {
+        reject_underlying(v, first);
+    }
+    
+    n = v.option_count;
+    i = 0;
+    for (; i + VALIDATION_BLOCK <= n; i += VALIDATION_BLOCK) {
+        std::int32_t bad_steps = 0;
+        std::uint8_t bad_type = 0;
+        for (std::size_t k = i; k < i + VALIDATION_BLOCK; ++k) {
+            bad_steps |= v.steps_until_expiry[k];
+            bad_type |= v.option_type[k];
+        }
+        if (bad_steps < 0 || bad_type > 1) {
+            reject_option(v, first_invalid_option(v, i, i + VALIDATION_BLOCK));
+        }
+    }
+    if (std::size_t first = first_invalid_option(v, i, n); first != n) {
+        reject_option(v, first);
+    }
+}
+
+Universe build_universe(const UniverseImage& image) {
+    const UniverseView& v = image.view();
+    validate_universe(v);
+    reject_duplicate_options(v);
+    
+    auto underlying_block = std::make_shared<std::vector<Underlying>>();
+    underlying_block->reserve(v.underlying_count);
+    std::vector<UnderlyingName> names;
+    names.reserve(v.underlying_count);
+    std::unordered_map<UnderlyingId, std::uint32_t> index_by_id;
+    index_by_id.reserve(v.underlying_count);
+    
+    for (std::size_t i = 0; i < v.underlying_count; ++i) {
+        if (!index_by_id.emplace(v.underlying_id[i], static_cast<std::uint32_t>(i)).second) {
+            throw std::invalid_argument("Duplicate underlying id " + std::to_string(v.underlying_id[i]));
+        }
+        names.emplace_back(v.underlying_name(i));
+        underlying_block->emplace_back(PREVALIDATED, std::string(v.underlying_name(i)), v.underlying_id[i],
+                                       v.valuation[i], v.down_move_probability[i], v.down_move_step[i],
+                                       v.noise_std_dev[i], v.up_move_probability[i], v.up_move_step[i]);
+    }
+    
+    auto option_block = std::make_shared<std::vector<Option>>();
+    option_block->reserve(v.option_count);
+    
+    for (std::size_t i = 0; i < v.option_count; ++i) {
+        auto it = index_by_id.find(v.option_underlying_id[i]);
+        if (it == index_by_id.end()) {
+            throw std::invalid_argument("Option " + std::to_string(v.option_id[i]) + " references unknown underlying "
+                                        + std::to_string(v.option_underlying_id[i]));
+        }
+        option_block->emplace_back(v.option_id[i], static_cast<OptionType>(v.option_type[i]),
+                                   v.steps_until_expiry[i], v.strike[i], v.option_underlying_id[i],
+                                   names[it->second]);
+    }
+    
+    Universe universe;
+    universe.underlyings.reserve(v.underlying_count);
+    for (const Underlying& underlying : *underlying_block) {
+        universe.underlyings.emplace_back(underlying_block, &underlying);
+    }
+    
+    universe.options.reserve(v.option_count);
+    for (const Option& option : *option_block) {
+        universe.options.emplace_back(option_block, &option);
+    }
+    
+    return universe;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "types.hpp"
+#include "option.hpp"
+#include "underlying.hpp"
+#include "snapshot.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+constexpr std::uint32_t UNIVERSE_MAGIC = 0x564E554D;
+constexpr std::uint32_t UNIVERSE_VERSION = 1;
+
+struct UniverseHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t total_size;
+    std::uint64_t underlying_count;
+    std::uint64_t option_count;
+    std::uint64_t string_table_size;
+};
+
+struct UniverseView {
+    std::size_t underlying_count = 0;
+    std::size_t option_count = 0;
+    std::size_t string_table_size = 0;
+    
+    const double* valuation = nullptr;
+    const double* down_move_probability = nullptr;
+    const double* down_move_step = nullptr;
+    const double* noise_std_dev = nullptr;
+    const double* up_move_probability = nullptr;
+    const double* up_move_step = nullptr;
+    const UnderlyingId* underlying_id = nullptr;
+    const std::uint32_t* name_offset = nullptr;
+    const std::uint32_t* name_length = nullptr;
+    
+    const OptionId* option_id = nullptr;
+    const UnderlyingId* option_underlying_id = nullptr;
+    const Steps* steps_until_expiry = nullptr;
+    const Strike* strike = nullptr;
+    const std::uint8_t* option_type = nullptr;
+    
+    const char* strings = nullptr;
+    
+    std::string_view underlying_name(std::size_t i) const noexcept {
+        return std::string_view(strings + name_offset[i], name_length[i]);
+    }
+};
+
+class UniverseImage {
+public:
+    static UniverseImage open(const std::string& path);
+    static UniverseImage parse_csv(std::string_view text);
+    
+    const UniverseView& view() const noexcept { return view_; }
+    const std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool is_mapped() const noexcept { return mapped_ != nullptr; }
+    
+    void write(const std::string& path) const;
+
+private:
+    std::vector<std::byte> owned_;
+    std::unique_ptr<MappedFile> mapped_;
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    UniverseView view_;
+    
+    void attach(const std::byte* data, std::size_t size);
+};
+
+struct Universe {
+    UnderlyingVector underlyings;
+    OptionVector options;
+};
+
+void validate_universe(const UniverseView& view);
+Universe build_universe(const UniverseImage& image);
\ No newline at end of file
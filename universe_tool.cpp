@@ -0,0 +1,109 @@
+#include "universe_loader.hpp"
+#include "market_maker.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void generate(const std::string& path, int underlying_count, int option_count) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write '" + path + "'");
+    }
+    
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<> spot_dist(20.0, 500.0);
+    std::uniform_int_distribution<> expiry_dist(1, 60);
+    
+    std::vector<double> spots(underlying_count);
+    out << "# U,id,name,valuation,down_prob,down_step,noise,up_prob,up_step\n";
+    for (int i = 0; i < underlying_count; ++i) {
+        spots[i] = std::round(spot_dist(gen) * 100.0) / 100.0;
+        double step = std::round(spots[i]) / 100.0 + 0.5;
+        out << "U," << i + 1 << ",TK" << i + 1 << "," << spots[i] << ",0.5," << step << ",0.1,0.5," << step << "\n";
+    }
+    
+    out << "# O,id,underlying_id,type,steps,strike\n";
+    for (int i = 0; i < option_count; ++i) {
+        int u = i % underlying_count;
+        int strike = static_cast<int>(spots[u]) + (i / underlying_count) % 21 - 10;
+        out << "O," << i + 1 << "," << u + 1 << "," << to_string_view((i % 2) ? OptionType::PUT : OptionType::CALL) << ","
+            << expiry_dist(gen) << "," << std::max(1, strike) << "\n";
+    }
+}
+
+void load(const std::string& path, bool into_market_maker) {
+    auto start = Clock::now();
+    UniverseImage image = UniverseImage::open(path);
+    double open_ms = elapsed_ms(start);
+    
+    start = Clock::now();
+    validate_universe(image.view());
+    double validate_ms = elapsed_ms(start);
+    
+    start = Clock::now();
+    Universe universe = build_universe(image);
+    double build_ms = elapsed_ms(start);
+    
+    std::cout << (image.is_mapped() ? "Mapped " : "Parsed ") << path << ": "
+                << universe.underlyings.size() << " underlyings, " << universe.options.size() << " options\n"
+                << std::fixed << std::setprecision(2)
+                << "  open     " << std::setw(10) << open_ms << " ms\n"
+                << "  validate " << std::setw(10) << validate_ms << " ms\n"
+                << "  build    " << std::setw(10) << build_ms << " ms (includes validation)\n";
+    
+    double total_ms = open_ms + build_ms;
+    if (into_market_maker) {
+        start = Clock::now();
+        MarketMaker mm{std::move(universe.underlyings), std::move(universe.options)};
+        double strategy_ms = elapsed_ms(start);
+        total_ms += strategy_ms;
+        std::cout << "  strategy " << std::setw(10) << strategy_ms << " ms ("
+                    << mm.position.option_slot_count() << " option slots)\n";
+    }
+    std::cout << "  total    " << std::setw(10) << total_ms << " ms\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::string_view command = argc > 1 ? argv[1] : "";
+    
+    try {
+        if (command == "generate" && argc >= 3) {
+            int underlyings = argc > 3 ? std::stoi(argv[3]) : 10000;
+            int options = argc > 4 ? std::stoi(argv[4]) : 1000000;
+            generate(argv[2], underlyings, options);
+        } else if (command == "compile" && argc == 4) {
+            auto start = Clock::now();
+            UniverseImage image = UniverseImage::open(argv[2]);
+            validate_universe(image.view());
+            image.write(argv[3]);
+            std::cout << "Compiled " << image.view().underlying_count << " underlyings and "
+                        << image.view().option_count << " options into " << argv[3] << " ("
+                        << image.size() << " bytes) in " << std::fixed << std::setprecision(1)
+                        << elapsed_ms(start) << " ms\n";
+        } else if (command == "load" && argc >= 3) {
+            load(argv[2], argc > 3 && std::string_view(argv[3]) == "--market-maker");
+        } else {
+            std::cerr << "Usage: " << argv[0] << " generate <out.csv> [underlyings] [options]\n"
+                        << "       " << argv[0] << " compile <in.csv> <out.univ>\n"
+                        << "       " << argv[0] << " load <universe> [--market-maker]\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
\ No newline at end of file
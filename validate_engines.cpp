@@ -0,0 +1,70 @@
+#include "pricing_engine.hpp"
+#include <iostream>
+#include <iomanip>
+
+int main(int argc, char* argv[]) {
+    std::size_t contract_count = 500;
+    std::uint64_t seed = 42;
+    Steps max_steps = 2000;
+    Price max_error = 1e-6;
+    Price max_delta_error = 1e-6;
+    Price max_gamma_error = 1e-6;
+    std::vector<std::string> candidates;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--contracts" && i + 1 < argc) {
+            contract_count = std::stoul(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--max-steps" && i + 1 < argc) {
+            max_steps = std::stoi(argv[++i]);
+        } else if (arg == "--max-error" && i + 1 < argc) {
+            max_error = std::stod(argv[++i]);
+        } else if (arg == "--max-delta-error" && i + 1 < argc) {
+            max_delta_error = std::stod(argv[++i]);
+        } else if (arg == "--max-gamma-error" && i + 1 < argc) {
+            max_gamma_error = std::stod(argv[++i]);
+        } else {
+            candidates.emplace_back(arg);
+        }
+    }
+    
+    try {
+        auto registry = PricingEngineRegistry::with_builtin_engines();
+        if (candidates.empty()) {
+            for (const auto& name : registry.names()) {
+                if (name != PricingEngineRegistry::REFERENCE) candidates.push_back(name);
+            }
+        }
+        
+        auto reference = registry.create(std::string(PricingEngineRegistry::REFERENCE));
+        auto contracts = random_contracts(contract_count, seed, max_steps);
+        
+        std::cout << "Validating against " << reference->name() << " over " << contracts.size()
+                    << " random contracts (seed " << seed << ", up to " << max_steps << " steps)\n";
+        std::cout << std::setw(16) << "engine" << std::setw(14) << "max price err"
+                    << std::setw(14) << "max delta err" << std::setw(14) << "max gamma err"
+                    << std::setw(10) << "speedup" << std::setw(10) << "worst" << std::setw(8) << "result\n";
+        
+        bool all_passed = true;
+        for (const auto& name : candidates) {
+            auto engine = registry.create(name);
+            EngineValidation v = validate_engine(*reference, *engine, contracts);
+            bool passed = v.max_price_error <= max_error && v.max_delta_error <= max_delta_error
+                          && v.max_gamma_error <= max_gamma_error;
+            all_passed = all_passed && passed;
+            
+            std::cout << std::setw(16) << engine->name() << std::scientific << std::setprecision(2)
+                        << std::setw(14) << v.max_price_error << std::setw(14) << v.max_delta_error
+                        << std::setw(14) << v.max_gamma_error
+                        << std::fixed << std::setprecision(2) << std::setw(9) << v.speedup() << "x"
+                        << std::setw(10) << v.worst_contract << std::setw(8) << (passed ? "ok" : "FAIL") << "\n";
+        }
+        
+        return all_passed ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file